@@ -0,0 +1,35 @@
+#ifndef FIRST_SOC_APPLICATIONS_IMAGE_APPLICATION_H
+#define FIRST_SOC_APPLICATIONS_IMAGE_APPLICATION_H
+
+#include <program/mapped_program_image.h>
+
+#include <hestia/component/component_base.h>
+
+#include <hestia/memory/i_memory.h>
+#include <hestia/port/write_port.h>
+
+#include <string>
+
+/**
+ * Generic driver that loads a program image produced by the assembler into memory and rings the
+ * doorbell with its entry point. The image is mapped on construction rather than read and relocated
+ * to wherever the memory allocates it, a missing or corrupt image fails validation.
+ */
+class ImageApplication : public hestia::ComponentBase {
+public:
+    explicit ImageApplication(const hestia::ComponentInit &init);
+
+    void Setup() noexcept override;
+
+    [[nodiscard]] bool Validate() const noexcept override { return m_image.IsValid(); }
+
+private:
+    hestia::WritePort<hestia::IMemory::Address> m_doorbell;
+
+    hestia::IMemory* m_memory;
+
+    const std::string m_image_file;
+    MappedProgramImage m_image;
+};
+
+#endif //FIRST_SOC_APPLICATIONS_IMAGE_APPLICATION_H
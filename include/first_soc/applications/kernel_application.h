@@ -0,0 +1,79 @@
+#ifndef FIRST_SOC_APPLICATIONS_KERNEL_APPLICATION_H
+#define FIRST_SOC_APPLICATIONS_KERNEL_APPLICATION_H
+
+#include <hestia/component/component_base.h>
+#include <hestia/counter/counter.h>
+
+#include <hestia/memory/i_memory.h>
+#include <hestia/port/write_port.h>
+
+#include <random>
+#include <string>
+#include <vector>
+
+/**
+ * Drives one of a suite of benchmark kernels written against the full ISA. The kernel is picked by
+ * the "kernel" parameter and its working set scales with the "size" parameter:
+ *   memcpy        Copy size words
+ *   dot           Dot product of two size word vectors
+ *   pointer_chase Follow a random cycle through size words, size times
+ *   histogram     Count size words into 16 bins
+ *   matmul        Multiply two size x size matrices
+ *   reduction     Sum size words in a called subroutine
+ * Inputs are generated on the host, the kernel is assembled with their addresses and the result is
+ * checked against a host computed reference on tear down, counted by the "passed" and "failed"
+ * counters. Kernels use registers 1 to 9.
+ */
+class KernelApplication : public hestia::ComponentBase {
+public:
+    explicit KernelApplication(const hestia::ComponentInit &init);
+
+    void Setup() noexcept override;
+
+    void TearDown() noexcept override;
+
+    [[nodiscard]] bool Validate() const noexcept override;
+
+private:
+
+    static constexpr uint64_t HISTOGRAM_BINS = 16;
+
+    /**
+     * Each kernel lays out its data and returns its assembly. The reference result is left in
+     * m_expected, to be compared against the same number of words at m_result_address.
+     */
+    std::string Memcpy();
+    std::string Dot();
+    std::string PointerChase();
+    std::string Histogram();
+    std::string Matmul();
+    std::string Reduction();
+
+    /**
+     * Allocate and fill a data region
+     * @return Address of the region
+     */
+    hestia::IMemory::Address AllocateData(const std::vector<uint64_t>& data);
+
+    /**
+     * @return Values in [0, max) from a fixed seed so every run sees the same data
+     */
+    std::vector<uint64_t> RandomData(uint64_t size, uint64_t max);
+
+    hestia::WritePort<hestia::IMemory::Address> m_doorbell;
+
+    hestia::IMemory* m_memory;
+
+    const std::string m_kernel;
+    const uint64_t m_size;
+
+    // Counters
+    hestia::Counter m_passed; /*!< Incremented when the result matches the reference >*/
+    hestia::Counter m_failed; /*!< Incremented when the result does not match the reference >*/
+
+    hestia::IMemory::Address m_result_address = 0;
+    std::vector<uint64_t> m_expected;
+    std::mt19937_64 m_random{1};
+};
+
+#endif //FIRST_SOC_APPLICATIONS_KERNEL_APPLICATION_H
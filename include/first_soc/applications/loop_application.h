@@ -4,11 +4,15 @@
 
 #include <functional/transactions/instruction.h>
 
+#include <reset/reset_handler.h>
+
 #include <hestia/component/component_base.h>
 
 #include <hestia/memory/i_memory.h>
 #include <hestia/port/write_port.h>
 
+#include <random>
+
 class LoopApplication : public hestia::ComponentBase {
 public:
     explicit LoopApplication(const hestia::ComponentInit &init);
@@ -19,10 +23,20 @@ public:
 
 private:
     /**
-     * Create an instruction based of run time params
-     * @return A Newly Created Instruction to be placed in loop
+     * Write the program, reusing the previous allocation when it fits, and ring the doorbell
+     */
+    void WriteProgram();
+
+    /**
+     * Pick up changed parameters and run again
+     */
+    void Reset();
+
+    /**
+     * Pick the next loop body instruction based of run time params
+     * @return True for an ADD, false for a MOVE
      */
-    Instruction CreateInstruction();
+    bool GenerateAlu();
     Instruction CreateAddInstruction();
     Instruction CreateMoveInstruction();
 
@@ -33,30 +47,29 @@ private:
      */
     static Instruction CreateENDPRGMInstruction();
 
-    std::vector<Instruction> LoopLogicInstructions();
-
     /**
-     * Will encode and add the instruction to a vector of memory
-     * @param instruction The instruction to be encoded
-     * @param surface The surface to append the instruction to
+     * Increment the count register and jump back to the start of the program until it reaches the iterations
      */
-    static void AddInstruction(const Instruction& instruction, std::vector<hestia::IMemory::Data>& surface);
-    static void AddInstruction(const std::vector<Instruction>& instructions, std::vector<hestia::IMemory::Data>& surface);
+    std::vector<Instruction> LoopLogicInstructions();
 
     hestia::WritePort<hestia::IMemory::Address> m_doorbell;
 
     hestia::IMemory* m_memory;
 
-    const uint64_t m_num_iterations;
-    const uint64_t m_num_ops_per_iteration;
+    uint64_t m_num_iterations;
+    uint64_t m_num_ops_per_iteration;
 
     hestia::IMemory::Address m_write_back_address = 0;
     hestia::IMemory::Address m_application_start_address = 0;
+    uint64_t m_program_capacity = 0; /*!< Words allocated at m_application_start_address >*/
     static uint64_t m_write_back_register;
     static uint64_t m_count_register;
 
-    const std::string m_instruction_type_mode;
+    std::string m_instruction_type_mode;
 
     bool m_generate_alu = false;
+    std::default_random_engine m_random{}; /*!< Picks the random mode instructions, reseeded on Reset >*/
+
+    ResetHandler m_reset_handler; /*!< Joins the group named by the reset_group parameter >*/
 };
 #endif //FIRST_SOC_APPLICATIONS_ALU_LOOP_APPLICATION_H
@@ -30,13 +30,6 @@ private:
      */
     static Instruction CreateENDPRGMInstruction();
 
-    /**
-     * Will encode and add the instruction to a vector of memory
-     * @param instruction The instruction to be encoded
-     * @param surface The surface to append the instruction to
-     */
-    static void AddInstruction(const Instruction& instruction, std::vector<hestia::IMemory::Data>& surface);
-
     hestia::WritePort<hestia::IMemory::Address> m_doorbell;
 
     hestia::IMemory* m_memory;
@@ -0,0 +1,89 @@
+#ifndef FIRST_SOC_APPLICATIONS_TRACE_REPLAY_DRIVER_H
+#define FIRST_SOC_APPLICATIONS_TRACE_REPLAY_DRIVER_H
+
+#include <memory_trace/memory_trace_reader.h>
+
+#include <hestia/connection/transaction_handler.h>
+#include <hestia/counter/counter.h>
+#include <hestia/memory/i_memory.h>
+#include <hestia/port/read_port.h>
+#include <hestia/toolbox/components/producer.h>
+#include <hestia/toolbox/transactions/memory_request.h>
+#include <hestia/toolbox/transactions/memory_response.h>
+
+#include <deque>
+#include <string>
+#include <utility>
+
+/**
+ * Replays a memory trace recorded by MemoryTraceObserver into a memory subsystem, so memory
+ * configurations can be evaluated without simulating a processor. Requests go out of the "requests"
+ * port and read responses come back on the "responses" port. The "mode" parameter picks when a
+ * request is issued:
+ *   timed         At its recorded cycle relative to the first record, or as soon after as the
+ *                 memory takes it (empty for timed)
+ *   back_pressure As soon as the memory takes it, ignoring the recorded cycles
+ * In both modes at most "max_outstanding" reads wait for their response, empty or 0 for no limit.
+ * Writes are posted and never outstanding. Written data is zero, only the addresses are replayed.
+ */
+class TraceReplayDriver : public hestia::ProducerComponent<hestia::MemoryRequest> {
+public:
+
+    enum class Mode : uint8_t {
+        TIMED = 0,
+        BACK_PRESSURE = 1,
+        INVALID = 2
+    };
+
+    explicit TraceReplayDriver(const hestia::ComponentInit& init);
+
+    [[nodiscard]] bool Validate() const noexcept override;
+
+    void Setup() noexcept override;
+
+    void TearDown() noexcept override;
+
+    [[nodiscard]] bool HasWork() const noexcept override;
+
+    hestia::MemoryRequest Produce() noexcept override;
+
+private:
+
+    static Mode ToMode(const std::string& name);
+
+    /**
+     * Match read responses to the reads we have outstanding
+     */
+    void ResponseReturn();
+
+    /**
+     * @return Cycle the next record is due at in timed mode
+     */
+    [[nodiscard]] uint64_t DueCycle() const noexcept { return m_next.cycle - m_first_cycle + m_start_cycle; }
+
+    // Ports
+    hestia::ReadPort<hestia::MemoryResponse> m_responses;
+
+    // Handlers
+    hestia::TransactionHandler m_response_handler;
+
+    memory_trace::MemoryTraceReader m_reader;
+    const Mode m_mode;
+    uint64_t m_max_outstanding = 0;
+
+    memory_trace::Record m_next{};   /*!< Next record to issue >*/
+    bool m_has_next = false;
+    uint64_t m_first_cycle = 0;     /*!< Recorded cycle of the first record >*/
+    uint64_t m_start_cycle = 0;     /*!< Cycle the replay started at >*/
+
+    std::deque<std::pair<hestia::IMemory::Address, uint64_t>> m_outstanding; /*!< Reads waiting for their response with their issue cycle >*/
+
+    // Counters
+    hestia::Counter m_reads;
+    hestia::Counter m_writes;
+    hestia::Counter m_responses_received;
+    hestia::Counter m_read_latency_cycles; /*!< Issue to response, summed over every read >*/
+    hestia::Counter m_late_cycles;         /*!< Timed mode, cycles requests went out after they were due >*/
+};
+
+#endif //FIRST_SOC_APPLICATIONS_TRACE_REPLAY_DRIVER_H
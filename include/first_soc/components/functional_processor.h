@@ -1,6 +1,11 @@
 #ifndef FIRST_SOC_FUNCTIONAL_PROCESSOR_H
 #define FIRST_SOC_FUNCTIONAL_PROCESSOR_H
 
+#include "components/processor_events.h"
+
+#include <log/event_log.h>
+#include <reset/reset_handler.h>
+
 #include <hestia/component/component_base.h>
 
 #include <functional/functional_processor_library.h>
@@ -20,7 +25,7 @@ public:
     explicit FunctionalProcessor(const hestia::ComponentInit& init);
     ~FunctionalProcessor() override = default;
 
-    [[nodiscard]] bool Validate() const noexcept override { return true; }
+    [[nodiscard]] bool Validate() const noexcept override { return !m_events.HasFailed(); }
 
 private:
 
@@ -46,6 +51,12 @@ private:
     // Counters
     hestia::Counter m_memory_fetches; /*!< Count how many memory requests we have made >*/
     hestia::Counter m_doorbell_rings; /*!< Count how many doorbell requests we have processed >*/
+
+    EventLog m_events; /*!< Binary event log, enabled by the event_log_file parameter >*/
+
+    // Reset
+    ResetHandler m_reset_handler; /*!< Joins the group named by the reset_group parameter >*/
+    void Reset();
 };
 
 #endif //FIRST_SOC_FUNCTIONAL_PROCESSOR_H
\ No newline at end of file
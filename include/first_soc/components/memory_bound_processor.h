@@ -3,6 +3,11 @@
 
 #include "functional/transactions/instruction.h"
 
+#include "components/processor_events.h"
+
+#include <log/event_log.h>
+#include <reset/reset_handler.h>
+
 #include <hestia/component/component_base.h>
 
 #include <hestia/connection/transaction_handler.h>
@@ -24,7 +29,7 @@ public:
     explicit MemoryBoundProcessor(const hestia::ComponentInit& init);
     ~MemoryBoundProcessor() override = default;
 
-    [[nodiscard]] bool Validate() const noexcept override { return true; }
+    [[nodiscard]] bool Validate() const noexcept override { return !m_events.HasFailed(); }
 
 private:
 
@@ -61,10 +66,15 @@ private:
     hestia::Counter m_memory_fetches;
     hestia::Counter m_doorbell_rings;
 
+    EventLog m_events; /*!< Binary event log, enabled by the event_log_file parameter >*/
+
     // Utility Functions
     void SendOperandRequests();
     void SendWriteBackRequests();
 
+    // Reset
+    ResetHandler m_reset_handler; /*!< Joins the group named by the reset_group parameter >*/
+    void Reset();
 };
 
 
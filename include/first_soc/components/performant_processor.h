@@ -2,7 +2,16 @@
 #define FIRST_SOC_PERFORMANT_PROCESSOR_H
 
 #include "functional/transactions/instruction.h"
+#include "timing_devices/hardware_contexts.h"
+#include "timing_devices/instruction_latencies.h"
+#include "timing_devices/pc_profile.h"
 #include "timing_devices/pipeline_stage.h"
+#include "timing_devices/pipeline_trace.h"
+
+#include "components/processor_events.h"
+
+#include <log/event_log.h>
+#include <reset/reset_handler.h>
 
 #include <hestia/component/component_base.h>
 
@@ -15,9 +24,13 @@
 #include <hestia/toolbox/connections/fifo.h>
 #include <functional/functional_processor_library.h>
 
+#include <deque>
+#include <utility>
+
 /**
  * Similar to our MemoryBoundProcessor, but with the addition of adding stages between each instruction phase
- * (Fetch, Decode, Execute, Write back)
+ * (Fetch, Decode, Execute, Write back). With num_contexts hardware thread contexts every context keeps one
+ * instruction in flight, so memory latency of one application is hidden behind the others.
  */
 class PerformantProcessor : public hestia::ComponentBase {
 public:
@@ -25,7 +38,9 @@ public:
     explicit PerformantProcessor(const hestia::ComponentInit& init);
     ~PerformantProcessor() override = default;
 
-    [[nodiscard]] bool Validate() const noexcept override { return true; }
+    [[nodiscard]] bool Validate() const noexcept override { return m_contexts.IsValid() && !m_events.HasFailed(); }
+
+    void TearDown() noexcept override;
 
 private:
 
@@ -64,22 +79,41 @@ private:
     hestia::TransactionHandler m_write_back_handler;
     void WriteBack();
     hestia::TransactionHandler m_write_back_back_pressure_handler;
+    hestia::TransactionHandler m_parked_handler;
+    void IssueParked();
 
     // Functional Library
     FunctionalProcessorLibrary m_functional_library;
+    HardwareContexts m_contexts;
 
     // Bookkeeping logic
 
     std::deque<hestia::MemoryRequest> m_operand_requests;
     std::deque<hestia::MemoryRequest> m_write_back_requests;
+    std::deque<std::pair<uint8_t, uint64_t>> m_fetches; /*!< Context and fetch cycle of every instruction before decode >*/
+    std::deque<Instruction> m_parked;                    /*!< Decoded instructions waiting on memory operands, in request order >*/
+    std::deque<uint8_t> m_write_back_blocked;            /*!< Contexts waiting for their write back requests to go out >*/
 
     // Counters
     hestia::Counter m_memory_fetches;
     hestia::Counter m_doorbell_rings;
 
+    EventLog m_events; /*!< Binary event log, enabled by the event_log_file parameter >*/
+    InstructionLatencies m_latencies;
+
+    // Timeline trace and per address profile
+    PipelineTrace m_trace;
+    PcProfile m_profile;
+    uint64_t m_return_cycle = 0; /*!< Cycle the instruction in the decoder was returned at >*/
+
     void ProcessFetch();
     void SendOperandRequests();
     void SendWriteBackRequests();
+    void GatherParked(const std::deque<hestia::MemoryResponse>& responses);
+
+    // Reset
+    ResetHandler m_reset_handler; /*!< Joins the group named by the reset_group parameter >*/
+    void Reset();
 };
 
 
@@ -2,7 +2,16 @@
 #define FIRST_SOC_PIPELINE_PROCESSOR_H
 
 #include "functional/transactions/instruction.h"
+#include "timing_devices/hardware_contexts.h"
+#include "timing_devices/instruction_latencies.h"
+#include "timing_devices/pc_profile.h"
 #include "timing_devices/pipeline_stage.h"
+#include "timing_devices/pipeline_trace.h"
+
+#include "components/processor_events.h"
+
+#include <log/event_log.h>
+#include <reset/reset_handler.h>
 
 #include <hestia/component/component_base.h>
 
@@ -15,13 +24,24 @@
 #include <hestia/toolbox/connections/fifo.h>
 #include <functional/functional_processor_library.h>
 
+#include <deque>
+#include <utility>
+
+/**
+ * Pipelined processor with num_contexts hardware thread contexts sharing the pipeline. Contexts
+ * fetch in the order picked by the fetch_policy parameter. With more than one context an
+ * instruction waiting on memory operands is parked outside the executor so the other contexts keep
+ * issuing behind it.
+ */
 class PipelinedProcessor : public hestia::ComponentBase {
 public:
 
     explicit PipelinedProcessor(const hestia::ComponentInit& init);
     ~PipelinedProcessor() override = default;
 
-    [[nodiscard]] bool Validate() const noexcept override { return true; }
+    [[nodiscard]] bool Validate() const noexcept override { return m_contexts.IsValid() && !m_events.HasFailed(); }
+
+    void TearDown() noexcept override;
 
 private:
 
@@ -62,26 +82,54 @@ private:
     hestia::TransactionHandler m_write_back_handler;
     void WriteBack();
     hestia::TransactionHandler m_write_back_back_pressure_handler;
+    hestia::TransactionHandler m_parked_handler;
+    void IssueParked();
 
     // Functional Library
     FunctionalProcessorLibrary m_functional_library;
+    HardwareContexts m_contexts;
 
     // Bookkeeping logic
 
+    using Destination = std::pair<uint8_t, hestia::IMemory::Address>; /*!< Context and register >*/
+
     std::deque<hestia::MemoryRequest> m_operand_requests;
     std::deque<hestia::MemoryRequest> m_write_back_requests;
-    std::deque<hestia::IMemory::Address> m_destination_registers;
+    std::deque<Destination> m_destination_registers;
     std::deque<hestia::IMemory::Address> m_destination_addresses;
+    std::deque<Destination> m_destination_vector_registers;
+    std::deque<uint8_t> m_fetch_contexts; /*!< Context of every instruction between fetch and decode >*/
+    std::deque<Instruction> m_parked;     /*!< Decoded instructions waiting on memory operands, in request order >*/
 
-    bool application_terminated = true;
+    uint64_t m_fetch_cycle = 0; /*!< Cycle the instruction in the fetcher was fetched at >*/
+    bool m_hazard_stalled = false; /*!< The instruction in the decoder failed the hazard check >*/
+    uint64_t m_stalled_cycle = 0;  /*!< Cycle it first failed at >*/
 
     // Counters
     hestia::Counter m_memory_fetches;
     hestia::Counter m_doorbell_rings;
 
+    EventLog m_events; /*!< Binary event log, enabled by the event_log_file parameter >*/
+    InstructionLatencies m_latencies;
+
+    // Timeline trace and per address profile
+    PipelineTrace m_trace;
+    PcProfile m_profile;
+    uint64_t m_return_cycle = 0; /*!< Cycle the instruction in the decoder was returned at >*/
+
     void ProcessFetch();
 
     bool HazardCheck(const Instruction &instruction);
+    void GatherParked(const std::deque<hestia::MemoryResponse>& responses);
+    /**
+     * Remove the entry of a retired instruction from a destination list, if it is still there
+     */
+    template <typename T>
+    static void Erase(std::deque<T>& destinations, const T& destination);
+
+    // Reset
+    ResetHandler m_reset_handler; /*!< Joins the group named by the reset_group parameter >*/
+    void Reset();
 };
 
 
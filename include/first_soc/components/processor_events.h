@@ -0,0 +1,44 @@
+#ifndef FIRST_SOC_PROCESSOR_EVENTS_H
+#define FIRST_SOC_PROCESSOR_EVENTS_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * Events logged by the processor models. Arguments of each event are listed next to it.
+ */
+enum class ProcessorEvent : uint16_t {
+    DOORBELL = 0,                   // application address
+    SENT_TO_FETCHER = 1,            // -
+    FETCHER_BACK_PRESSURE = 2,      // -
+    INSTRUCTION_REQUESTED = 3,      // address
+    INSTRUCTION_FETCH_BACK_PRESSURE = 4, // -
+    SENT_TO_DECODER = 5,            // -
+    DECODER_BACK_PRESSURE = 6,      // -
+    SENT_TO_EXECUTOR = 7,           // opcode
+    BRANCHING = 8,                  // opcode
+    HAZARD_STALL = 9,               // opcode
+    EXECUTOR_BACK_PRESSURE = 10,    // -
+    OPERAND_REQUESTED = 11,         // address
+    OPERAND_BACK_PRESSURE = 12,     // outstanding requests
+    OPERANDS_RECEIVED = 13,         // number of responses
+    EXECUTED = 14,                  // opcode
+    WRITE_BACK_BACK_PRESSURE = 15,  // -
+    WRITTEN_BACK = 16,              // opcode
+    WRITE_BACK_REQUESTED = 17,      // address
+    WRITE_BACK_REQUEST_BACK_PRESSURE = 18 // outstanding requests
+};
+
+inline const std::vector<std::string>& ProcessorEventNames() {
+    static const std::vector<std::string> names = {
+            "doorbell", "sent_to_fetcher", "fetcher_back_pressure", "instruction_requested",
+            "instruction_fetch_back_pressure", "sent_to_decoder", "decoder_back_pressure",
+            "sent_to_executor", "branching", "hazard_stall", "executor_back_pressure",
+            "operand_requested", "operand_back_pressure", "operands_received", "executed",
+            "write_back_back_pressure", "written_back", "write_back_requested",
+            "write_back_request_back_pressure"};
+    return names;
+}
+
+#endif //FIRST_SOC_PROCESSOR_EVENTS_H
@@ -0,0 +1,25 @@
+#ifndef FIRST_SOC_FUNCTIONAL_EVENTS_H
+#define FIRST_SOC_FUNCTIONAL_EVENTS_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * Events logged by the FunctionalProcessorLibrary. Arguments of each event are listed next to it.
+ */
+enum class FunctionalEvent : uint16_t {
+    APPLICATION_STARTED = 0,    // start address
+    FETCHED = 1,                // address
+    EXECUTED = 2,               // opcode | result type << 16 | flags before << 24 | flags after << 28,
+                                // operand 0 value, operand 1 value, result value
+    APPLICATION_TERMINATED = 3  // -
+};
+
+inline const std::vector<std::string>& FunctionalEventNames() {
+    static const std::vector<std::string> names = {
+            "application_started", "fetched", "executed", "application_terminated"};
+    return names;
+}
+
+#endif //FIRST_SOC_FUNCTIONAL_EVENTS_H
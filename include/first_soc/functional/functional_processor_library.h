@@ -3,42 +3,74 @@
 
 #include <hestia/base/manageable.h>
 
+#include "functional_events.h"
 #include "transactions/instruction.h"
+#include "transactions/instruction_batch.h"
+
+#include <log/event_log.h>
 
 #include <hestia/base/init.h>
 #include <hestia/counter/counter.h>
-#include <hestia/log/logger.h>
 #include <hestia/memory/i_memory.h>
 #include <hestia/toolbox/transactions/memory_response.h>
 
+#include <array>
 #include <deque>
+#include <string>
+#include <vector>
 
 /**
  * The Functional Processor Library handles all of the low level details of the instruction cycle from
  * start of the application until it's termination.
+ * Parameters: num_registers, plus num_vector_registers and vector_length which default to
+ * DEFAULT_NUM_VECTOR_REGISTERS and DEFAULT_VECTOR_LENGTH when not set.
  */
 class FunctionalProcessorLibrary : public hestia::Manageable {
 public:
 
-    FunctionalProcessorLibrary(std::string name, const hestia::Init& init);
+    static constexpr uint64_t MAX_CONTEXTS = 256; /*!< Instruction::context is 8 bits >*/
+    static constexpr uint64_t DEFAULT_NUM_VECTOR_REGISTERS = 4;
+    static constexpr uint64_t DEFAULT_VECTOR_LENGTH = 8;
+
+    /**
+     * @param num_contexts Hardware thread contexts, each with its own program counter, registers and
+     * flags. Instructions pick theirs through Instruction::context. None are created if there are more
+     * than MAX_CONTEXTS, failing Validate.
+     */
+    FunctionalProcessorLibrary(std::string name, const hestia::Init& init, uint64_t num_contexts = 1);
 
     /**
      * Set the initial address of the application
+     * @param context A free context, see IsRunning
+     */
+    void SetApplicationStart(hestia::IMemory::Address, uint8_t context = 0);
+
+    /**
+     * @return True from SetApplicationStart until the context executes ENDPRGM
+     */
+    [[nodiscard]] bool IsRunning(uint8_t context) const { return m_contexts[context].program_counter != 0; }
+
+    [[nodiscard]] uint64_t GetNumContexts() const noexcept { return m_contexts.size(); }
+
+    /**
+     * Clear registers, flags and the call stack of every context as if no application had run.
+     * Counters and the event log keep going.
      */
-    void SetApplicationStart(hestia::IMemory::Address);
+    void Reset();
 
     /**
      * Generates a Memory request for the next instruction
      * @return Memory request with address pointing at the location for the next address
      */
-    hestia::MemoryRequest Fetch();
+    hestia::MemoryRequest Fetch(uint8_t context = 0);
 
     /**
      * Processes a memory response containing the encoded instruction.
      * @param response Memory response containing the instruction
+     * @param context Context the instruction was fetched for
      * @return Valid Instruction set to Decoded stage
      */
-    Instruction Decode(const hestia::MemoryResponse& response);
+    Instruction Decode(const hestia::MemoryResponse& response, uint8_t context = 0);
 
     /**
      * Gathers operands from various possible locations. For constant / indirect memory based operands
@@ -70,24 +102,125 @@ public:
     std::deque<hestia::MemoryRequest> WriteBack(Instruction& instruction);
 
     /**
-     * Validates that funclib has at least 1 register
+     * Names of the instruction mix counters relative to the library, e.g. mix.ADD.operands.registers.
+     * Per opcode executed, operand type and result type counts plus mix.branches.taken / not_taken.
+     */
+    static std::vector<std::string> MixCounterNames();
+
+    /**
+     * Validates that funclib has at least 1 register, non empty vectors and its event log could be created
      * @return True if has at least 1 register
      */
-    bool Validate() const noexcept override { return !m_registers.empty(); }
+    bool Validate() const noexcept override {
+        return !m_contexts.empty() && !m_contexts[0].registers.empty() && m_vector_length != 0 && !m_events.HasFailed();
+    }
+
+    /**
+     * Current value of a register, used by timing models to resolve indirect memory hazards
+     */
+    [[nodiscard]] uint64_t GetRegister(uint64_t location, uint8_t context = 0) const {
+        return m_contexts[context].registers[location];
+    }
+
+    /**
+     * Number of elements in a vector register, set by the vector_length parameter, DEFAULT_VECTOR_LENGTH if unset
+     */
+    [[nodiscard]] uint64_t GetVectorLength() const noexcept { return m_vector_length; }
+
+    /**
+     * Number of words an indirect memory operand of the opcode reads, a whole vector for vector opcodes
+     */
+    [[nodiscard]] uint64_t GetOperandSize(Opcode opcode) const;
+
+    /**
+     * Number of words a memory result of the opcode writes, a whole vector for vector opcodes except VREDUCE
+     */
+    [[nodiscard]] uint64_t GetResultSize(Opcode opcode) const;
+
+    /***
+     * Field index of the result in an EXTEND prefix, operands use their own index
+     */
+    static constexpr uint8_t EXTEND_RESULT = 2;
+
+    /***
+     * Words in an EXTEND prefix, the prefix instruction and its constant
+     */
+    static constexpr uint8_t EXTEND_SIZE = 2;
+
+    /***
+     * Most words a single instruction can encode to: a constant or a prefix per operand, a prefix for
+     * the result and the instruction word itself
+     */
+    static constexpr uint8_t MAX_ENCODED_SIZE = 7;
 
     /***
-     * Encode an instruction into raw bytes for easier storing in simulated memory
+     * Encode an instruction into raw bytes for easier storing in simulated memory. Register locations,
+     * embedded values and result locations that do not fit their 8 bit metadata field are carried by
+     * EXTEND prefixes placed before the instruction word.
      * @param instruction A valid Instruction
      * @return Raw bytes representing the instruction
      */
     static std::vector<uint64_t> Encode(const Instruction& instruction);
 
+    /***
+     * Encode an instruction straight into a caller owned buffer, avoiding a vector per instruction
+     * @param instruction A valid Instruction
+     * @param out Buffer with room for at least EncodedSize(instruction) words
+     * @return One past the last word written
+     */
+    static uint64_t* Encode(const Instruction& instruction, uint64_t* out);
+
+    /***
+     * @param instruction A valid Instruction
+     * @return Number of raw words the instruction encodes to, including any EXTEND prefixes
+     */
+    static uint8_t EncodedSize(const Instruction& instruction);
+
+    /***
+     * Encode an EXTEND prefix. The value replaces the field of the next decoded instruction, for
+     * operands the register location or embedded value and for the result its location.
+     * @param field Operand index or EXTEND_RESULT
+     * @param value Full value of the field
+     * @param out Buffer with room for at least EXTEND_SIZE words
+     * @return One past the last word written
+     */
+    static uint64_t* EncodeExtend(uint8_t field, uint64_t value, uint64_t* out);
+
+    /***
+     * Decode the first word of an encoded instruction. Constant operands are left for gathering and
+     * EXTEND prefixes are decoded as instructions of their own.
+     * @param encoded The first raw word of an instruction
+     * @return Instruction set to Decoded stage
+     */
+    static Instruction Decode(uint64_t encoded);
+
+    /***
+     * Decode a block of encoded instructions at once, for tools that scan whole program images. The
+     * fields are extracted with AVX2 when built with ENABLE_AVX2, falling back to scalar code otherwise.
+     * @param words Instructions as written by Encode, each followed by its constant operands
+     * @param num_words Number of words in the block
+     * @param batch Batch to fill in, previous contents are replaced
+     * @return Number of words decoded, less than num_words if the last instruction is missing constants
+     */
+    static size_t Decode(const uint64_t* words, size_t num_words, InstructionBatch& batch);
+
 private:
 
     using OpcodeEncodedType = std::bitset<16>;
     using OperandEncodedType = std::bitset<24>; // One byte per Operand + Result
     using OperandMetadata = std::bitset<24>; // One byte per Operand + Result
 
+    /**
+     * @return True if the field needs an EXTEND prefix
+     */
+    static bool IsWide(const Operand& operand);
+    static bool IsWide(const Result& result);
+
+    /**
+     * Replace the fields latched by EXTEND prefixes since the last instruction
+     */
+    void ApplyExtensions(Instruction& instruction) const;
+
     static OperandEncodedType EncodeOperandTypes(const Instruction& instruction);
     static OperandMetadata EncodeOperandMetaData(const Instruction& instruction);
 
@@ -96,8 +229,9 @@ private:
     static bool MultiplicationOverflow(int64_t a, int64_t b);
 
     static void ExecuteMemory(Instruction& instruction);
-    static void ExecuteAlu(Instruction& instruction);
+    void ExecuteAlu(Instruction& instruction);
     void ExecuteControl(Instruction& instruction);
+    void ExecuteVector(Instruction& instruction);
 
     struct Counters {
         struct Instruction {
@@ -115,6 +249,7 @@ private:
             hestia::Counter constants;
             hestia::Counter indirect_memories;
             hestia::Counter embedded;
+            hestia::Counter vector_registers;
 
             Operand(const std::string& name, hestia::Manageable* owner, const hestia::Init& init);
         } operands;
@@ -126,17 +261,64 @@ private:
             Application(const std::string& name, hestia::Manageable* owner, const hestia::Init& init);
         } applications;
 
+        /**
+         * Faults in the guest program, each handled as documented on its opcode
+         */
+        struct Error {
+            hestia::Counter divide_by_zero;
+            hestia::Counter empty_call_stack; /*!< RETURN without a matching CALL >*/
+
+            Error(const std::string& name, hestia::Manageable* owner, const hestia::Init& init);
+        } errors;
+
+        /**
+         * Dynamic instruction mix, counted as instructions execute, result types when they are gathered
+         * so indirect results are counted before they resolve to memory. Opcodes find their counters
+         * through a lookup table so counting stays a few increments per instruction.
+         */
+        struct Mix {
+            struct OpcodeCounters {
+                hestia::Counter executed;
+                std::deque<hestia::Counter> operands; /*!< One per Operand::Type >*/
+                std::deque<hestia::Counter> results;  /*!< One per Result::Type, as decoded before indirect results are resolved >*/
+
+                OpcodeCounters(const std::string& name, hestia::Manageable* owner, const hestia::Init& init);
+            };
+
+            std::deque<OpcodeCounters> opcodes;
+            std::array<uint8_t, 256> indices{}; /*!< Opcode to index into opcodes >*/
+            hestia::Counter taken;              /*!< JUMP, CALL, RETURN and JUMP_LESS with carry set >*/
+            hestia::Counter not_taken;          /*!< JUMP_LESS with carry clear >*/
+
+            Mix(const std::string& name, hestia::Manageable* owner, const hestia::Init& init);
+
+            void Gather(const ::Instruction& instruction);
+            void Execute(const ::Instruction& instruction);
+        } mix;
+
         Counters(const std::string& name, hestia::Manageable* owner, const hestia::Init& init);
     } m_counters;
 
-    hestia::IMemory::Address m_program_counter = 0;
-
     using Register = hestia::IMemory::Data;
-    std::vector<Register> m_registers;
-    Flags m_flags{};
 
-    hestia::Logger m_logger;
-    hestia::Logger m_instruction_trace;
+    /**
+     * Architectural state of one hardware thread
+     */
+    struct Context {
+        hestia::IMemory::Address program_counter = 0;
+        std::vector<Register> registers;
+        Flags flags{};
+        std::vector<hestia::IMemory::Address> call_stack; /*!< Return addresses pushed by CALL >*/
+        std::array<uint64_t, EXTEND_RESULT + 1> extensions{}; /*!< Field values latched by EXTEND prefixes >*/
+        uint8_t extended = 0; /*!< Bit per field in extensions waiting for the next instruction >*/
+        std::vector<int64_t> vector_registers; /*!< All vector registers back to back, m_vector_length elements each >*/
+    };
+
+    const uint64_t m_vector_length;
+    std::vector<Context> m_contexts;
+
+    const hestia::Init& m_init;
+    EventLog m_events; /*!< Application and per instruction trace events >*/
 
 };
 
@@ -20,7 +20,8 @@ struct Operand {
         REGISTER = 0, // Our operand comes from a register
         CONSTANT = 1, // Our operand is in memory sequentially behind instruction
         INDIRECT_MEMORY_REGISTER = 2, // The address of our operand is in a register
-        EMBEDDED = 3 // Our operand is embedded into the opcode meta data
+        EMBEDDED = 3, // Our operand is embedded into the opcode meta data
+        VECTOR_REGISTER = 4 // Our operand is a whole vector register
     };
 
     /**
@@ -39,6 +40,8 @@ struct Operand {
     uint64_t location = 0;
     // The value that will be utilized by the processor
     int64_t value    = 0;
+    // Elements of a vector operand, empty for scalars
+    std::vector<int64_t> values;
 };
 
 struct Flags {
@@ -59,7 +62,9 @@ struct Result {
     enum class Type : uint8_t {
         NONE = 0,
         REGISTER = 1,
-        MEMORY = 2
+        MEMORY = 2,
+        INDIRECT_MEMORY_REGISTER = 3, // The address to store to is in a register, resolved to MEMORY when gathered
+        VECTOR_REGISTER = 4
     };
 
     // Meta data about the result
@@ -67,6 +72,7 @@ struct Result {
     uint64_t location = 0;
     // Actual result created by the processor
     int64_t value = 0;
+    std::vector<int64_t> values; // Elements of a vector result, empty for scalars
     Flags flags{};
 };
 
@@ -83,11 +89,28 @@ struct Instruction {
         FINISHED = 3,
     };
 
+    /**
+     * Cycles at which the instruction completed each phase. Only filled in by the timing models.
+     */
+    struct Timestamps {
+        uint64_t fetched = 0;
+        uint64_t returned = 0;
+        uint64_t stalled = 0;  // First decode attempt, earlier than decoded if the hazard check held it back
+        uint64_t decoded = 0;
+        uint64_t gathered = 0;
+        uint64_t blocked = 0;  // Ready to execute, earlier than executed if write back was full
+        uint64_t executed = 0;
+        uint64_t written_back = 0;
+    };
+
     Opcode opcode = Opcode::ENDPRGM;
     std::vector<Operand> operands;
     Phase phase = Phase::FETCHED;
     uint8_t size = 0;
+    uint8_t context = 0; // Hardware thread context of the processor the instruction belongs to
+    uint64_t address = 0; // Where the instruction word was fetched from
     Result result{};
+    Timestamps timestamps{};
 
     bool OperandsGathered() const;
 
@@ -0,0 +1,44 @@
+#ifndef FIRST_SOC_INSTRUCTION_BATCH_H
+#define FIRST_SOC_INSTRUCTION_BATCH_H
+
+#include "instruction.h"
+
+#include <cstdint>
+#include <vector>
+
+/**
+ * A block of decoded instructions stored as one array per field, filled in by
+ * FunctionalProcessorLibrary::Decode(words, num_words, batch). Fields are kept as the raw encoded
+ * bytes, operand fields past GetDetails(opcode).num_operands are meaningless. Constant operands are
+ * not decoded, they follow the instruction word in operand order. EXTEND prefixes are decoded as
+ * instructions of their own.
+ */
+struct InstructionBatch {
+
+    static constexpr size_t MAX_OPERANDS = 2;
+
+    std::vector<uint32_t> offsets;                          /*!< Word offset of the instruction in the block >*/
+    std::vector<uint16_t> opcodes;
+    std::vector<uint8_t> operand_types[MAX_OPERANDS];
+    std::vector<uint8_t> operand_meta_data[MAX_OPERANDS];   /*!< Register location or embedded value >*/
+    std::vector<uint8_t> result_types;
+    std::vector<uint8_t> result_locations;
+
+    [[nodiscard]] size_t size() const noexcept { return offsets.size(); }
+
+    void clear() noexcept;
+
+    /**
+     * Resize every field, only used by the decoder
+     */
+    void resize(size_t size);
+
+    /**
+     * Rebuild a single instruction, identical to decoding its word with FunctionalProcessorLibrary::Decode
+     * @param index Instruction in the batch
+     * @return Instruction set to Decoded stage
+     */
+    [[nodiscard]] Instruction Get(size_t index) const;
+};
+
+#endif //FIRST_SOC_INSTRUCTION_BATCH_H
@@ -2,6 +2,7 @@
 #define HESTIA_EXAMPLES_FIRST_SOC_ISA_H
 
 #include <cstdint>
+#include <string>
 #include <unordered_map>
 
 enum class Opcode : uint16_t {
@@ -9,14 +10,20 @@ enum class Opcode : uint16_t {
     ADD = 1, // Execute instruction on the ALU to add together the two operands
     SUBTRACT = 2,
     MULTIPLY = 3,
-    DIVIDE = 4,
+    DIVIDE = 4, // Division by zero results in 0 with the carry flag set
     INCREMENT = 5,
     DECREMENT = 6,
     COMPARE = 7,
     JUMP = 8, // Set the program counter to the result of the jump instruction
     JUMP_LESS = 9, // If carry flag is set after a compare instruction will jump to memory location.
-    CALL = 9, // Push current program counter to the stack and jump to the call location
-    RETURN = 10, // Pop off the stack and set the program counter to the result and.
+    RETURN = 10, // Pop off the stack and set the program counter to the result and. Does nothing on an empty stack
+    CALL = 11, // Push current program counter to the stack and jump to the call location
+    VLOAD = 12, // Load a vector, from memory through an indirect operand or broadcast from a scalar
+    VSTORE = 13, // Store a vector register to memory
+    VADD = 14, // Element wise add of two vectors, scalar operands are broadcast
+    VMUL = 15, // Element wise multiply of two vectors, scalar operands are broadcast
+    VREDUCE = 16, // Sum the elements of a vector into a scalar
+    EXTEND = 17, // Prefix carrying the full value of one field of the next instruction, see FunctionalProcessorLibrary::EncodeExtend
     ENDPRGM = 0xFFu // Terminate the application
 };
 
@@ -30,7 +37,8 @@ struct OpcodeDetails {
     enum class Type {
         MEMORY = 0,
         ALU = 1,
-        BRANCH = 2
+        BRANCH = 2,
+        VECTOR = 3
     };
 
     Type type = Type::MEMORY;
@@ -49,5 +57,11 @@ const std::unordered_map<Opcode, OpcodeDetails>& GetDetails();
  */
 const OpcodeDetails& GetDetails(Opcode);
 
+/***
+ * Get the mnemonic of an opcode.
+ * @return
+ */
+std::string to_string(Opcode);
+
 
 #endif //HESTIA_EXAMPLES_FIRST_SOC_ISA_H
@@ -0,0 +1,36 @@
+#ifndef FIRST_SOC_OBSERVERS_MEMORY_TRACE_H
+#define FIRST_SOC_OBSERVERS_MEMORY_TRACE_H
+
+#include <memory_trace/memory_trace_writer.h>
+#include <timing/cycle.h>
+
+#include <hestia/observer/i_connection_observer.h>
+#include <hestia/toolbox/transactions/memory_request.h>
+
+/**
+ * Records every memory request pushed onto an instruction_request or data_request connection to
+ * <observer name>.mtrace, see memory_trace_format.h. Blocks are compressed when zlib is available.
+ */
+class MemoryTraceObserver : public hestia::IConnectionObserver<hestia::MemoryRequest> {
+public:
+    explicit MemoryTraceObserver(const hestia::ObserverInit& init) :
+            hestia::IConnectionObserver<hestia::MemoryRequest>(init),
+            m_observer_init(init),
+            m_writer(init.name + ".mtrace") {}
+
+    void Pushed(const hestia::MemoryRequest& request, uint32_t) noexcept override {
+        auto type = request.type == hestia::MemoryRequest::Type::WRITE ? memory_trace::Type::WRITE
+                                                                        : memory_trace::Type::READ;
+        m_writer.Append(CurrentCycle(m_observer_init), type, request.address, request.size);
+    }
+
+    void Popped(const hestia::MemoryRequest&, uint32_t) noexcept override {}
+
+    bool Validate() const noexcept override { return m_writer.IsOpen(); }
+
+private:
+    const hestia::ObserverInit m_observer_init;
+    memory_trace::MemoryTraceWriter m_writer;
+};
+
+#endif //FIRST_SOC_OBSERVERS_MEMORY_TRACE_H
@@ -0,0 +1,374 @@
+#ifndef FIRST_SOC_PROCESSOR_TEST_BENCH_H
+#define FIRST_SOC_PROCESSOR_TEST_BENCH_H
+
+#include "components/memory_bound_processor.h"
+#include "components/functional_processor.h"
+#include "components/performant_processor.h"
+#include "components/pipelined_processor.h"
+#include "applications/simple_application.h"
+#include "applications/loop_application.h"
+#include "applications/image_application.h"
+#include "applications/kernel_application.h"
+#include "applications/trace_replay_driver.h"
+#include "observers/doorbell.h"
+#include "observers/memory_trace.h"
+#include "components/channel_receiver.h"
+#include "components/channel_sender.h"
+#include "components/memory_view.h"
+
+#include <counter_store/counter_source.h>
+#include <reset/reset_handler.h>
+
+#include <hestia/toolbox/components/memory.h>
+#include <hestia/toolbox/transactions/memory_request.h>
+#include <hestia/toolbox/transactions/memory_response.h>
+#include <hestia/testbench/cpp_test_bench.h>
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * Test bench with every first_soc component registered, plus the wiring shared by the first_soc
+ * executables: a processor connected to a memory and driven by the loop driver, a program image or a
+ * benchmark kernel. The same design can also be split in two partitions joined by channels, see
+ * ParallelSimulation.
+ */
+class ProcessorTestBench : public hestia::CppTestBench, public counter_store::ICounterSource {
+public:
+
+    struct Config {
+        std::string processor = "functional_processor"; /*!< Component type of the processor >*/
+        std::string mode = "memory";                    /*!< Loop driver instruction mode >*/
+        uint64_t num_iterations = 2;
+        uint64_t num_ops_per_iteration = 5;
+        uint64_t memory_size = 1024;
+        uint64_t num_registers = 10;
+        uint64_t num_vector_registers = FunctionalProcessorLibrary::DEFAULT_NUM_VECTOR_REGISTERS;
+        uint64_t vector_length = FunctionalProcessorLibrary::DEFAULT_VECTOR_LENGTH; /*!< Elements per vector register >*/
+        uint64_t num_contexts = 1;                      /*!< Hardware thread contexts of the pipelined processors >*/
+        std::string fetch_policy = "round_robin";       /*!< Context fetch policy, round_robin or icount >*/
+        std::string application = "loop_driver";        /*!< Component type of the applications: loop_driver, image_driver or kernel_driver >*/
+        std::string image_file;                         /*!< Program image run by the image driver >*/
+        std::string kernel = "memcpy";                  /*!< Benchmark kernel run by the kernel driver >*/
+        uint64_t kernel_size = 64;                      /*!< Working set of the kernel, see KernelApplication >*/
+        uint64_t num_applications = 1;                  /*!< Applications ringing the processor's doorbell >*/
+        std::string event_log_file;                     /*!< Functional library event log, empty to disable >*/
+        std::string processor_event_log_file;           /*!< Processor event log, empty to disable >*/
+        std::string trace_file;                         /*!< Pipeline trace, empty to disable >*/
+        std::string profile_file;                       /*!< Per address profile of the pipelined processors, empty to disable >*/
+    };
+
+    /**
+     * Memory only design replaying recorded memory traces, see TraceReplayDriver
+     */
+    struct ReplayConfig {
+        std::vector<std::string> trace_files;           /*!< One replay driver per trace >*/
+        std::string mode = "timed";                     /*!< timed or back_pressure >*/
+        uint64_t max_outstanding = 0;                   /*!< Reads in flight per driver, 0 for no limit >*/
+        uint64_t memory_size = 1024;                    /*!< Has to cover every address in the traces >*/
+    };
+
+    const std::string processor_name = "processor";
+    const std::string application_name = "simple_application";
+    const std::string memory_component_name = "ram";
+    const std::string memory_name = "mem";
+    const std::string reset_group = NextResetGroup();
+
+    ProcessorTestBench() : hestia::CppTestBench() {
+        AddComponentFactories({
+            {"functional_processor", hestia::CreateComponent<FunctionalProcessor>},
+            {"memory_bound_processor", hestia::CreateComponent<MemoryBoundProcessor>},
+            {"performant_processor", hestia::CreateComponent<PerformantProcessor>},
+            {"pipelined_processor", hestia::CreateComponent<PipelinedProcessor>},
+            {"simple_driver", hestia::CreateComponent<SimpleApplication>},
+            {"loop_driver", hestia::CreateComponent<LoopApplication>},
+            {"image_driver", hestia::CreateComponent<ImageApplication>},
+            {"kernel_driver", hestia::CreateComponent<KernelApplication>},
+            {"trace_replay_driver", hestia::CreateComponent<TraceReplayDriver>},
+            {"memory", hestia::CreateComponent<hestia::MemoryComponent>},
+            {"memory_view", hestia::CreateComponent<MemoryView>},
+            {"doorbell_sender", hestia::CreateComponent<ChannelSender<hestia::IMemory::Address>>},
+            {"doorbell_receiver", hestia::CreateComponent<ChannelReceiver<hestia::IMemory::Address>>},
+            {"request_sender", hestia::CreateComponent<ChannelSender<hestia::MemoryRequest>>},
+            {"request_receiver", hestia::CreateComponent<ChannelReceiver<hestia::MemoryRequest>>},
+            {"response_sender", hestia::CreateComponent<ChannelSender<hestia::MemoryResponse>>},
+            {"response_receiver", hestia::CreateComponent<ChannelReceiver<hestia::MemoryResponse>>}
+        });
+        AddObserverFactories({
+            {"doorbell", hestia::CreateObserver<DoorbellDumper>},
+            {"memory_trace", hestia::CreateObserver<MemoryTraceObserver>}
+        });
+    }
+
+    /**
+     * Create the processor, its memory and its applications and connect them
+     */
+    void Build(const Config& config) {
+        const bool is_functional = config.processor == "functional_processor";
+
+        AddDomain("clk", 1);
+        CreateMemory(memory_name, {hestia::MemoryParameters::Type::LINEAR, config.memory_size});
+        m_memory_size = config.memory_size;
+        SetParameters(config);
+
+        // Create our components
+        CreateProcessor(config);
+        if (!is_functional) {
+            CreateComponent("memory", memory_component_name);
+        }
+        CreateApplications(config);
+
+        auto connection_parameters = ConnectionParameters();
+        for (uint64_t i = 0; i < config.num_applications; i++) {
+            CreateConnection(ApplicationName(i), "doorbell", processor_name, "doorbell", connection_parameters);
+        }
+        if (!is_functional) {
+            CreateConnection(processor_name, "instruction_request", memory_component_name, "requests", connection_parameters);
+            CreateConnection(processor_name, "data_request", memory_component_name, "requests", connection_parameters);
+            CreateConnection(memory_component_name, "responses", processor_name, "instruction_response", connection_parameters);
+            CreateConnection(memory_component_name, "responses", processor_name, "data_response", connection_parameters);
+        }
+    }
+
+    /**
+     * Create the memory and one replay driver per trace, all sharing the memory like the
+     * instruction and data ports of a processor do
+     */
+    void BuildReplay(const ReplayConfig& config) {
+        AddDomain("clk", 1);
+        CreateMemory(memory_name, {hestia::MemoryParameters::Type::LINEAR, config.memory_size});
+        SetParameter(hestia::FrameworkType::COMPONENT, memory_component_name, "memory_name", memory_name);
+        CreateComponent("memory", memory_component_name);
+
+        auto connection_parameters = ConnectionParameters();
+        for (uint64_t i = 0; i < config.trace_files.size(); i++) {
+            auto name = ReplayDriverName(i);
+            SetParameter(hestia::FrameworkType::COMPONENT, name, "trace_file", config.trace_files[i]);
+            SetParameter(hestia::FrameworkType::COMPONENT, name, "mode", config.mode);
+            SetParameter(hestia::FrameworkType::COMPONENT, name, "max_outstanding", std::to_string(config.max_outstanding));
+            CreateComponent("trace_replay_driver", name);
+            CreateConnection(name, "requests", memory_component_name, "requests", connection_parameters);
+            CreateConnection(memory_component_name, "responses", name, "responses", connection_parameters);
+        }
+    }
+
+    /**
+     * The first replay driver is named trace_replay_driver, the others get their index appended
+     */
+    static std::string ReplayDriverName(uint64_t index) {
+        return index == 0 ? "trace_replay_driver" : "trace_replay_driver" + std::to_string(index);
+    }
+
+    /**
+     * Return an idle design to its state right after Setup without rebuilding it, for back to back
+     * runs. Components re-read their runtime parameters, the loop driver rewrites its program and
+     * rings the doorbell again. The scheduler time keeps running.
+     */
+    void Reset() {
+        for (auto& counter : m_counters) {
+            counter.baseline = hestia::CppTestBench::GetCounterValue(counter.name);
+        }
+        ResetRegistry::Instance().Reset(reset_group);
+    }
+
+    /**
+     * Reset with new runtime parameters, only the loop driver settings may differ from the config the
+     * design was built with. The memory is not re-created and keeps the size it was built with. A loop
+     * driver whose program outgrows its previous allocation writes it to a new one, so the memory has
+     * to be built with room for every program size it is reset to.
+     * @return False, without resetting, if the config asks for more memory than the design was built with
+     */
+    bool Reset(const Config& config) {
+        if (config.memory_size > m_memory_size) {
+            return false;
+        }
+        SetParameters(config);
+        Reset();
+        return true;
+    }
+
+    /**
+     * Counter value since the last Reset. hestia counters cannot be cleared, so this is relative to
+     * the value at the last Reset for every counter read at least once before that Reset.
+     */
+    uint64_t GetCounterValue(const std::string& name) const {
+        return GetCounterValue(ResolveCounter(name));
+    }
+
+    /**
+     * Counter value since the last Reset, of a counter resolved once up front
+     */
+    uint64_t GetCounterValue(Handle handle) const {
+        auto const& counter = m_counters[handle];
+        return hestia::CppTestBench::GetCounterValue(counter.name) - counter.baseline;
+    }
+
+    /**
+     * Resolve a counter name once, for counters read over and over such as by a sampler
+     */
+    Handle ResolveCounter(const std::string& name) const override {
+        auto found = m_counter_handles.emplace(name, m_counters.size());
+        if (found.second) {
+            m_counters.push_back({name, 0});
+        }
+        return found.first->second;
+    }
+
+    void ReadCounters(const Handle* handles, size_t num_handles, uint64_t* values) const override {
+        for (size_t i = 0; i < num_handles; i++) {
+            values[i] = GetCounterValue(handles[i]);
+        }
+    }
+
+    /**
+     * Create the channels between the two partitions of one processor, before building either
+     * partition. The functional processor reads memory directly and cannot be partitioned.
+     * @param prefix Unique per processor, passed again to the partition builders
+     * @param latency Cycles taken by every cross partition connection
+     */
+    static void CreateChannels(const std::string& prefix, uint64_t latency) {
+        auto& registry = ChannelRegistry::Instance();
+        registry.Create<hestia::IMemory::Address>(prefix + "_doorbell", latency);
+        registry.Create<hestia::MemoryRequest>(prefix + "_instruction_request", latency);
+        registry.Create<hestia::MemoryRequest>(prefix + "_data_request", latency);
+        registry.Create<hestia::MemoryResponse>(prefix + "_instruction_response", latency);
+        registry.Create<hestia::MemoryResponse>(prefix + "_data_response", latency);
+    }
+
+    /**
+     * Processor half of a partitioned design, only the processor and the channel ends facing it
+     */
+    void BuildProcessorPartition(const Config& config, const std::string& prefix) {
+        AddDomain("clk", 1);
+        SetParameters(config);
+        CreateProcessor(config);
+
+        CreateReceiver("doorbell_receiver", prefix + "_doorbell", processor_name, "doorbell");
+        CreateSender("request_sender", prefix + "_instruction_request", processor_name, "instruction_request");
+        CreateSender("request_sender", prefix + "_data_request", processor_name, "data_request");
+        CreateReceiver("response_receiver", prefix + "_instruction_response", processor_name, "instruction_response");
+        CreateReceiver("response_receiver", prefix + "_data_response", processor_name, "data_response");
+    }
+
+    /**
+     * Memory half of a partitioned design, the memory and the applications that fill it
+     */
+    void BuildMemoryPartition(const Config& config, const std::string& prefix) {
+        AddDomain("clk", 1);
+        CreateMemory(memory_name, {hestia::MemoryParameters::Type::LINEAR, config.memory_size});
+        m_memory_size = config.memory_size;
+        SetParameters(config);
+        CreateComponent("memory", memory_component_name);
+        CreateApplications(config);
+
+        CreateSender("doorbell_sender", prefix + "_doorbell", application_name, "doorbell");
+        for (uint64_t i = 1; i < config.num_applications; i++) {
+            CreateConnection(ApplicationName(i), "doorbell", prefix + "_doorbell", "in", ConnectionParameters());
+        }
+        CreateReceiver("request_receiver", prefix + "_instruction_request", memory_component_name, "requests");
+        CreateReceiver("request_receiver", prefix + "_data_request", memory_component_name, "requests");
+        CreateSender("response_sender", prefix + "_instruction_response", memory_component_name, "responses");
+        CreateSender("response_sender", prefix + "_data_response", memory_component_name, "responses");
+    }
+
+private:
+
+    void SetParameters(const Config& config) {
+        for (uint64_t i = 0; i < config.num_applications; i++) {
+            auto name = ApplicationName(i);
+            SetParameter(hestia::FrameworkType::COMPONENT, name, "memory_name", memory_name);
+            SetParameter(hestia::FrameworkType::COMPONENT, name, "num_ops_per_iteration", std::to_string(config.num_ops_per_iteration));
+            SetParameter(hestia::FrameworkType::COMPONENT, name, "num_iterations", std::to_string(config.num_iterations));
+            SetParameter(hestia::FrameworkType::COMPONENT, name, "mode", config.mode);
+            SetParameter(hestia::FrameworkType::COMPONENT, name, "image_file", config.image_file);
+            SetParameter(hestia::FrameworkType::COMPONENT, name, "kernel", config.kernel);
+            SetParameter(hestia::FrameworkType::COMPONENT, name, "size", std::to_string(config.kernel_size));
+            SetParameter(hestia::FrameworkType::COMPONENT, name, "reset_group", reset_group);
+        }
+
+        SetParameter(hestia::FrameworkType::COMPONENT, processor_name + ".functional", "num_registers", std::to_string(config.num_registers));
+        SetParameter(hestia::FrameworkType::COMPONENT, processor_name + ".functional", "num_vector_registers", std::to_string(config.num_vector_registers));
+        SetParameter(hestia::FrameworkType::COMPONENT, processor_name + ".functional", "vector_length", std::to_string(config.vector_length));
+        SetParameter(hestia::FrameworkType::COMPONENT, processor_name + ".functional", "event_log_file", config.event_log_file);
+        SetParameter(hestia::FrameworkType::COMPONENT, processor_name, "event_log_file", config.processor_event_log_file);
+        SetParameter(hestia::FrameworkType::COMPONENT, processor_name, "memory_name", memory_name);
+        SetParameter(hestia::FrameworkType::COMPONENT, processor_name, "trace_file", config.trace_file);
+        SetParameter(hestia::FrameworkType::COMPONENT, processor_name, "profile_file", config.profile_file);
+        SetParameter(hestia::FrameworkType::COMPONENT, processor_name, "num_contexts", std::to_string(config.num_contexts));
+        SetParameter(hestia::FrameworkType::COMPONENT, processor_name, "fetch_policy", config.fetch_policy);
+        SetParameter(hestia::FrameworkType::COMPONENT, memory_component_name, "memory_name", memory_name);
+
+        SetParameter(hestia::FrameworkType::COMPONENT, processor_name, "reset_group", reset_group);
+    }
+
+    /**
+     * The first application keeps the plain application name
+     */
+    std::string ApplicationName(uint64_t index) const {
+        return index == 0 ? application_name : application_name + std::to_string(index);
+    }
+
+    void CreateApplications(const Config& config) {
+        for (uint64_t i = 0; i < config.num_applications; i++) {
+            CreateComponent(config.application, ApplicationName(i));
+        }
+    }
+
+    static std::string NextResetGroup() {
+        static uint64_t next_group = 0;
+        return "processor_test_bench" + std::to_string(next_group++);
+    }
+
+    static hestia::ConnectionParameters ConnectionParameters() {
+        hestia::ConnectionParameters connection_parameters{};
+        connection_parameters.is_timed = true;
+        connection_parameters.domain = "clk";
+        connection_parameters.is_observable = true;
+        return connection_parameters;
+    }
+
+    void CreateProcessor(const Config& config) {
+        const bool is_pipelined = config.processor == "performant_processor" ||
+                                  config.processor == "pipelined_processor";
+        if (is_pipelined) {
+            auto connection_parameters = ConnectionParameters();
+            SetConnectionParameters("processor.fetcher.processor.fetcher", connection_parameters);
+            SetConnectionParameters("processor.decoder.processor.decoder", connection_parameters);
+            SetConnectionParameters("processor.executor.processor.executor", connection_parameters);
+            SetConnectionParameters("processor.write_back.processor.write_back", connection_parameters);
+        }
+        CreateComponent(config.processor, processor_name);
+    }
+
+    /**
+     * Channel end named after its channel, fed from a port of this partition
+     */
+    void CreateSender(const std::string& type, const std::string& channel, const std::string& component,
+                      const std::string& port) {
+        SetParameter(hestia::FrameworkType::COMPONENT, channel, "channel", channel);
+        CreateComponent(type, channel);
+        CreateConnection(component, port, channel, "in", ConnectionParameters());
+    }
+
+    /**
+     * Channel end named after its channel, feeding a port of this partition
+     */
+    void CreateReceiver(const std::string& type, const std::string& channel, const std::string& component,
+                        const std::string& port) {
+        SetParameter(hestia::FrameworkType::COMPONENT, channel, "channel", channel);
+        CreateComponent(type, channel);
+        CreateConnection(channel, "out", component, port, ConnectionParameters());
+    }
+
+    struct ResolvedCounter {
+        std::string name;
+        uint64_t baseline; /*!< Counter value at the last Reset >*/
+    };
+
+    uint64_t m_memory_size = 0;                                       /*!< Words of the memory the design was built with >*/
+    mutable std::vector<ResolvedCounter> m_counters;                  /*!< Indexed by Handle >*/
+    mutable std::unordered_map<std::string, Handle> m_counter_handles;
+};
+
+#endif //FIRST_SOC_PROCESSOR_TEST_BENCH_H
@@ -0,0 +1,90 @@
+#ifndef FIRST_SOC_PROGRAM_ASSEMBLER_H
+#define FIRST_SOC_PROGRAM_ASSEMBLER_H
+
+#include "program/program_image.h"
+
+#include <functional/transactions/instruction.h>
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * Two pass assembler for the first_soc ISA.
+ *
+ * One statement per line, ';' starts a comment:
+ *   label:                         Labels may also prefix a statement on the same line
+ *   ADD r1, 2 -> r1                Mnemonics are the names from to_string(Opcode)
+ *   MOVE [r2] -> @result           [rN] reads memory at the address held in register N
+ *   COMPARE r1, #1000              #N forces a constant word, plain numbers above 255 become one
+ *   JUMP_LESS loop                 Label operands are always constant words
+ *   VADD v1, [r2] -> v1            vN is a vector register, vector opcodes read a whole vector through [rN]
+ *   result: .word 0                Data word, a number or a label
+ *           .space 4               N zeroed data words
+ *           .entry start           First instruction to run, defaults to the start of the image
+ *           .origin 16             Address the image is assembled for, before any words
+ *
+ * Results are "-> rN" for a register, "-> vN" for a vector register, "-> @N" / "-> @label" for memory
+ * or "-> [rN]" for memory at the address held in register N.
+ * Registers go up to r65535 and memory results may be anywhere, fields too wide for the instruction
+ * word get an EXTEND prefix. Memory results at labels always get one.
+ */
+class Assembler {
+public:
+
+    /**
+     * Assemble a program
+     * @param source Assembly text
+     * @param image Image to fill in
+     * @return False on error, see GetError
+     */
+    bool Assemble(const std::string& source, ProgramImage& image);
+
+    /**
+     * @return Description of the last error, prefixed with the line it happened on
+     */
+    [[nodiscard]] const std::string& GetError() const noexcept { return m_error; }
+
+    /**
+     * Turn encoded words back into assembly text, one instruction per line prefixed with its address
+     * @param words Encoded instructions
+     * @param address Address of the first word
+     * @return Assembly text
+     */
+    static std::string Disassemble(const std::vector<uint64_t>& words, uint64_t address = 0);
+
+private:
+
+    /**
+     * An operand or data value as written in the source, labels are resolved in the second pass
+     */
+    struct Value {
+        int64_t number = 0;
+        std::string label;
+    };
+
+    struct Statement {
+        size_t line = 0;
+        uint64_t offset = 0;
+        bool is_data = false;
+        Instruction instruction{};
+        std::vector<Value> values;      /*!< Operand values, or data words for .word / .space >*/
+        Value result{};
+    };
+
+    bool ParseLine(size_t line, std::string text, ProgramImage& image);
+    bool ParseInstruction(const std::string& mnemonic, const std::string& arguments, Statement& statement);
+    bool ParseOperand(const std::string& text, Operand& operand, Value& value);
+    bool ParseValue(const std::string& text, Value& value);
+    bool Resolve(const Value& value, uint64_t& address);
+    bool Fail(const std::string& message);
+
+    std::vector<Statement> m_statements;
+    std::unordered_map<std::string, uint64_t> m_labels;  /*!< Label to offset from the start of the image >*/
+    std::string m_entry;
+    uint64_t m_offset = 0;
+    size_t m_line = 0;
+    std::string m_error;
+};
+
+#endif //FIRST_SOC_PROGRAM_ASSEMBLER_H
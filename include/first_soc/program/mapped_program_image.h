@@ -0,0 +1,46 @@
+#ifndef FIRST_SOC_PROGRAM_MAPPED_PROGRAM_IMAGE_H
+#define FIRST_SOC_PROGRAM_MAPPED_PROGRAM_IMAGE_H
+
+#include "program/program_image.h"
+
+#include <cstdint>
+#include <string>
+
+/**
+ * A program image mapped straight from its file instead of being read into vectors. The mapping is
+ * private, so relocating only copies the pages holding relocated words and the file is never
+ * changed. The words can be handed to a memory directly from the mapping.
+ */
+class MappedProgramImage {
+public:
+
+    explicit MappedProgramImage(const std::string& file);
+    ~MappedProgramImage();
+
+    MappedProgramImage(const MappedProgramImage&) = delete;
+    MappedProgramImage& operator=(const MappedProgramImage&) = delete;
+
+    [[nodiscard]] bool IsValid() const noexcept { return m_words != nullptr; }
+
+    [[nodiscard]] uint64_t GetLoadAddress() const noexcept { return m_header.load_address; }
+    [[nodiscard]] uint64_t GetEntry() const noexcept { return m_header.entry; }
+    [[nodiscard]] uint64_t GetNumWords() const noexcept { return m_header.num_words; }
+    [[nodiscard]] const uint64_t* GetWords() const noexcept { return m_words; }
+
+    /**
+     * Move every relocated address so the image can be placed at a new address
+     * @param address Address the image will be loaded at
+     * @return False if a relocation points outside the words or has an unknown field
+     */
+    bool Relocate(uint64_t address);
+
+private:
+    uint8_t* m_data = nullptr;
+    size_t m_size = 0;
+
+    ProgramImage::ImageHeader m_header{};
+    uint64_t* m_words = nullptr;
+    const uint64_t* m_relocations = nullptr;
+};
+
+#endif //FIRST_SOC_PROGRAM_MAPPED_PROGRAM_IMAGE_H
@@ -0,0 +1,85 @@
+#ifndef FIRST_SOC_PROGRAM_PROGRAM_IMAGE_H
+#define FIRST_SOC_PROGRAM_PROGRAM_IMAGE_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * A program assembled ahead of time, ready to be copied into simulated memory.
+ *
+ * On disk layout:
+ * | ImageHeader | uint64_t words[num_words] | uint64_t relocations[num_relocations] |
+ *
+ * Words are exactly what FunctionalProcessorLibrary::Encode produces, laid out as if the image was
+ * loaded at load_address. Every word holding an absolute address has a relocation so the image can
+ * be loaded anywhere, a relocation is packed as (word offset << 2) | Relocation::Field.
+ */
+class ProgramImage {
+public:
+
+    static constexpr char MAGIC[8] = {'H', 'P', 'I', 'M', 'A', 'G', 'E', '\0'};
+    static constexpr uint32_t VERSION = 1;
+
+    struct ImageHeader {
+        char     magic[8];
+        uint32_t version;
+        uint32_t reserved;
+        uint64_t load_address;    // Address the words were assembled for
+        uint64_t entry;           // Offset of the first instruction from the start of the image
+        uint64_t num_words;
+        uint64_t num_relocations;
+    };
+
+    static_assert(sizeof(ImageHeader) == 48, "ImageHeader layout must stay stable");
+
+    struct Relocation {
+        /**
+         * Which part of the word holds the address
+         */
+        enum class Field : uint8_t {
+            WORD = 0    // The whole word, constant operands, EXTEND prefixes and data
+        };
+
+        uint64_t offset = 0;
+        Field field = Field::WORD;
+
+        [[nodiscard]] uint64_t Pack() const noexcept { return offset << 2u | static_cast<uint64_t>(field); }
+        static Relocation Unpack(uint64_t packed) noexcept {
+            return {packed >> 2u, static_cast<Field>(packed & 0x3u)};
+        }
+    };
+
+    uint64_t load_address = 0;
+    uint64_t entry = 0;
+    std::vector<uint64_t> words;
+    std::vector<Relocation> relocations;
+
+    /**
+     * Move every relocated address so the image can be placed at a new address
+     * @param address Address the image will be loaded at
+     * @return False if a relocation points outside the words or has an unknown field
+     */
+    bool Relocate(uint64_t address);
+
+    /**
+     * Move the address held in one field of a word
+     * @param word Word to patch
+     * @param field Part of the word holding the address
+     * @param delta Distance the image moved
+     * @return False if the field is unknown
+     */
+    static bool Relocate(uint64_t& word, Relocation::Field field, uint64_t delta);
+
+    /**
+     * @return False if the file could not be written
+     */
+    bool Write(const std::string& file) const;
+
+    /**
+     * @return False if the file could not be read or is not a valid image
+     */
+    bool Read(const std::string& file);
+};
+
+#endif //FIRST_SOC_PROGRAM_PROGRAM_IMAGE_H
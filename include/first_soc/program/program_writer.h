@@ -0,0 +1,88 @@
+#ifndef FIRST_SOC_PROGRAM_PROGRAM_WRITER_H
+#define FIRST_SOC_PROGRAM_PROGRAM_WRITER_H
+
+#include <functional/functional_processor_library.h>
+#include <functional/transactions/instruction.h>
+
+#include <hestia/memory/i_memory.h>
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+static_assert(std::is_same<hestia::IMemory::Data, uint64_t>::value, "Encoded words are stored as memory data");
+
+/**
+ * Streams encoded instructions into an already allocated region of simulated memory. Words are
+ * encoded into a fixed size buffer which is handed to the memory whenever it fills up, so building
+ * a program never holds more than one chunk of it outside of the memory.
+ */
+class ProgramWriter {
+public:
+
+    static constexpr size_t CHUNK_WORDS = 1u << 12u;
+
+    /**
+     * @param memory Memory to write to
+     * @param address Start of a region large enough for the whole program
+     */
+    ProgramWriter(hestia::IMemory* memory, hestia::IMemory::Address address) :
+            m_memory(memory),
+            m_address(address) {}
+
+    ~ProgramWriter() { Flush(); }
+
+    ProgramWriter(const ProgramWriter&) = delete;
+    ProgramWriter& operator=(const ProgramWriter&) = delete;
+
+    void Add(const Instruction& instruction) {
+        if (m_size + FunctionalProcessorLibrary::MAX_ENCODED_SIZE > CHUNK_WORDS) {
+            Flush();
+        }
+        m_size = FunctionalProcessorLibrary::Encode(instruction, m_chunk.data() + m_size) - m_chunk.data();
+    }
+
+    void Add(const std::vector<Instruction>& instructions) {
+        for (auto const& instruction : instructions) {
+            Add(instruction);
+        }
+    }
+
+    /**
+     * Add words that are already encoded, such as a pre encoded instruction or data
+     */
+    void Add(const uint64_t* words, size_t num_words) {
+        while (num_words != 0) {
+            if (m_size == CHUNK_WORDS) {
+                Flush();
+            }
+            auto count = std::min(num_words, CHUNK_WORDS - m_size);
+            std::copy(words, words + count, m_chunk.data() + m_size);
+            m_size += count;
+            words += count;
+            num_words -= count;
+        }
+    }
+
+    /**
+     * Hand everything buffered so far to the memory
+     */
+    void Flush() {
+        if (m_size != 0) {
+            m_memory->Set(m_address, m_chunk.data(), m_size);
+            m_address += m_size;
+            m_size = 0;
+        }
+    }
+
+private:
+
+    hestia::IMemory* m_memory;
+    hestia::IMemory::Address m_address;
+    std::array<uint64_t, CHUNK_WORDS> m_chunk{};
+    size_t m_size = 0;
+};
+
+#endif //FIRST_SOC_PROGRAM_PROGRAM_WRITER_H
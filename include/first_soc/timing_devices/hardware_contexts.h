@@ -0,0 +1,168 @@
+#ifndef FIRST_SOC_TIMING_DEVICES_HARDWARE_CONTEXTS_H
+#define FIRST_SOC_TIMING_DEVICES_HARDWARE_CONTEXTS_H
+
+#include "functional/transactions/instruction.h"
+
+#include <functional/functional_processor_library.h>
+
+#include <hestia/base/init.h>
+#include <hestia/base/manageable.h>
+#include <hestia/counter/counter.h>
+#include <hestia/memory/i_memory.h>
+
+#include <deque>
+#include <limits>
+#include <string>
+
+/**
+ * Hardware thread contexts of a multithreaded processor sharing one backend. Doorbells queue until a
+ * context is free and the fetch policy picks which context fetches next, either round robin or
+ * ICOUNT (the context with the fewest instructions between fetch and retire, ties round robin).
+ * A context is free once its application terminated and its last instruction retired.
+ */
+class HardwareContexts {
+public:
+
+    enum class FetchPolicy : uint8_t {
+        ROUND_ROBIN = 0,
+        ICOUNT = 1
+    };
+
+    HardwareContexts(const std::string& name, hestia::Manageable* owner, const hestia::Init& init,
+                     uint64_t num_contexts, const std::string& fetch_policy) :
+            m_valid(num_contexts > 0 && num_contexts <= FunctionalProcessorLibrary::MAX_CONTEXTS) {
+        if (fetch_policy == "icount") {
+            m_policy = FetchPolicy::ICOUNT;
+        } else if (!fetch_policy.empty() && fetch_policy != "round_robin") {
+            m_valid = false;
+        }
+        // An unsupported count is left to fail validation rather than allocating it
+        for (uint64_t context = 0; m_valid && context < num_contexts; context++) {
+            m_contexts.emplace_back(name + std::to_string(context) + ".", owner, init);
+        }
+    }
+
+    /**
+     * @param parameter Value of a num_contexts parameter
+     * @return Number of contexts it asks for, a single context if it is empty
+     */
+    static uint64_t NumContexts(const std::string& parameter) {
+        return parameter.empty() ? 1 : std::stoull(parameter);
+    }
+
+    /**
+     * @return False if the number of contexts or the fetch policy parameter is not supported
+     */
+    [[nodiscard]] bool IsValid() const noexcept { return m_valid; }
+
+    [[nodiscard]] size_t size() const noexcept { return m_contexts.size(); }
+
+    /**
+     * Queue an application until a context is free
+     */
+    void Ring(hestia::IMemory::Address address) { m_doorbells.push_back(address); }
+
+    /**
+     * Start queued applications on every free context
+     * @return True if any application was started
+     */
+    bool Start(FunctionalProcessorLibrary& library) {
+        bool started = false;
+        for (size_t index = 0; index < m_contexts.size() && !m_doorbells.empty(); index++) {
+            auto& context = m_contexts[index];
+            if (context.running || context.in_flight != 0 || library.IsRunning(static_cast<uint8_t>(index))) {
+                continue;
+            }
+            library.SetApplicationStart(m_doorbells.front(), static_cast<uint8_t>(index));
+            m_doorbells.pop_front();
+            context.running = true;
+            context.blocked = 0;
+            ++context.applications;
+            started = true;
+        }
+        return started;
+    }
+
+    /**
+     * Pick the context that fetches next, nothing changes until Fetched is called
+     * @param context Set to the chosen context
+     * @param max_in_flight Contexts with this many instructions in flight are skipped
+     * @return False if no context can fetch
+     */
+    bool Select(uint8_t& context, uint64_t max_in_flight = std::numeric_limits<uint64_t>::max()) const noexcept {
+        bool found = false;
+        for (size_t offset = 0; offset < m_contexts.size(); offset++) {
+            auto index = (m_next + offset) % m_contexts.size();
+            auto const& candidate = m_contexts[index];
+            if (!candidate.running || candidate.blocked != 0 || candidate.in_flight >= max_in_flight) {
+                continue;
+            }
+            if (!found || (m_policy == FetchPolicy::ICOUNT && candidate.in_flight < m_contexts[context].in_flight)) {
+                context = static_cast<uint8_t>(index);
+                found = true;
+            }
+            if (m_policy == FetchPolicy::ROUND_ROBIN) {
+                break;
+            }
+        }
+        return found;
+    }
+
+    void Fetched(uint8_t context) {
+        ++m_contexts[context].in_flight;
+        ++m_contexts[context].fetched;
+        m_next = (context + 1) % m_contexts.size();
+    }
+
+    /**
+     * Stop a context from fetching, e.g. until its branch resolves. Blocks nest.
+     */
+    void Block(uint8_t context) noexcept { ++m_contexts[context].blocked; }
+    void Unblock(uint8_t context) noexcept { --m_contexts[context].blocked; }
+
+    /**
+     * The application on a context decoded its ENDPRGM, nothing more is fetched for it
+     */
+    void Terminate(uint8_t context) noexcept { m_contexts[context].running = false; }
+
+    void Retire(const Instruction& instruction) {
+        auto& context = m_contexts[instruction.context];
+        --context.in_flight;
+        ++context.retired;
+    }
+
+    void Reset() noexcept {
+        m_doorbells.clear();
+        m_next = 0;
+        for (auto& context : m_contexts) {
+            context.running = false;
+            context.blocked = 0;
+            context.in_flight = 0;
+        }
+    }
+
+private:
+
+    struct Context {
+        bool running = false;   /*!< Between the doorbell and the decode of ENDPRGM >*/
+        uint64_t blocked = 0;   /*!< Nested reasons the context may not fetch >*/
+        uint64_t in_flight = 0; /*!< Fetched but not retired >*/
+
+        hestia::Counter applications;
+        hestia::Counter fetched;
+        hestia::Counter retired;
+
+        Context(const std::string& name, hestia::Manageable* owner, const hestia::Init& init) :
+                applications(name + "applications", owner, init),
+                fetched(name + "fetched", owner, init),
+                retired(name + "retired", owner, init) {}
+    };
+
+    bool m_valid;
+    FetchPolicy m_policy = FetchPolicy::ROUND_ROBIN;
+    std::deque<Context> m_contexts;
+    std::deque<hestia::IMemory::Address> m_doorbells;
+    size_t m_next = 0; /*!< Context after the one that fetched last >*/
+};
+
+#endif //FIRST_SOC_TIMING_DEVICES_HARDWARE_CONTEXTS_H
@@ -0,0 +1,83 @@
+#ifndef FIRST_SOC_TIMING_DEVICES_INSTRUCTION_LATENCIES_H
+#define FIRST_SOC_TIMING_DEVICES_INSTRUCTION_LATENCIES_H
+
+#include "functional/transactions/instruction.h"
+
+#include <hestia/base/init.h>
+#include <hestia/base/manageable.h>
+#include <hestia/counter/counter.h>
+
+#include <array>
+#include <deque>
+#include <string>
+
+/**
+ * Per opcode latency histograms fed by retiring instructions. Latencies go into fixed log2
+ * buckets (bucket 0 is 0 cycles, bucket n covers [2^(n-1), 2^n) and the last bucket is open
+ * ended) and the cycles spent in every phase are accumulated so we can see where they went.
+ */
+class InstructionLatencies {
+public:
+
+    static constexpr size_t NUM_BUCKETS = 16;
+
+    InstructionLatencies(const std::string& name, hestia::Manageable* owner, const hestia::Init& init) {
+        m_indices.fill(NO_INDEX);
+        for (auto const& detail : GetDetails()) {
+            m_indices[static_cast<uint8_t>(detail.first)] = static_cast<uint8_t>(m_opcodes.size());
+            m_opcodes.emplace_back(name + "." + to_string(detail.first) + ".", owner, init);
+        }
+    }
+
+    /**
+     * Record an instruction that has been written back
+     */
+    void Retire(const Instruction& instruction) noexcept {
+        auto index = m_indices[static_cast<uint8_t>(instruction.opcode)];
+        if (index == NO_INDEX) {
+            return;
+        }
+        auto& counters = m_opcodes[index];
+        auto const& timestamps = instruction.timestamps;
+        ++counters.buckets[Bucket(timestamps.written_back - timestamps.fetched)];
+        counters.fetch_cycles += timestamps.decoded - timestamps.fetched;
+        counters.gather_cycles += timestamps.gathered - timestamps.decoded;
+        counters.execute_cycles += timestamps.executed - timestamps.gathered;
+        counters.write_back_cycles += timestamps.written_back - timestamps.executed;
+    }
+
+    static size_t Bucket(uint64_t latency) noexcept {
+        if (latency == 0) {
+            return 0;
+        }
+        size_t bucket = 64 - __builtin_clzll(latency);
+        return bucket < NUM_BUCKETS ? bucket : NUM_BUCKETS - 1;
+    }
+
+private:
+
+    static constexpr uint8_t NO_INDEX = 0xFFu;
+
+    struct OpcodeCounters {
+        std::deque<hestia::Counter> buckets;
+        hestia::Counter fetch_cycles;      /*!< Fetch until decode >*/
+        hestia::Counter gather_cycles;     /*!< Decode until all operands gathered >*/
+        hestia::Counter execute_cycles;    /*!< Operands gathered until executed >*/
+        hestia::Counter write_back_cycles; /*!< Executed until written back >*/
+
+        OpcodeCounters(const std::string& name, hestia::Manageable* owner, const hestia::Init& init) :
+                fetch_cycles(name + "fetch_cycles", owner, init),
+                gather_cycles(name + "gather_cycles", owner, init),
+                execute_cycles(name + "execute_cycles", owner, init),
+                write_back_cycles(name + "write_back_cycles", owner, init) {
+            for (size_t bucket = 0; bucket < NUM_BUCKETS; bucket++) {
+                buckets.emplace_back(name + "bucket_" + std::to_string(bucket), owner, init);
+            }
+        }
+    };
+
+    std::deque<OpcodeCounters> m_opcodes;
+    std::array<uint8_t, 256> m_indices{}; /*!< Opcode to index into m_opcodes >*/
+};
+
+#endif //FIRST_SOC_TIMING_DEVICES_INSTRUCTION_LATENCIES_H
@@ -0,0 +1,125 @@
+#ifndef FIRST_SOC_TIMING_DEVICES_PC_PROFILE_H
+#define FIRST_SOC_TIMING_DEVICES_PC_PROFILE_H
+
+#include "functional/transactions/instruction.h"
+
+#include <program/assembler.h>
+
+#include <hestia/memory/i_memory.h>
+
+#include <algorithm>
+#include <cinttypes>
+#include <cstdio>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+/**
+ * Flat profile of the cycles retired instructions spent between fetch and write back, per program
+ * counter. Every instruction's cycles are split into
+ *   fetch      Fetched until its first decode attempt
+ *   hazard     Held in the decoder by the hazard check
+ *   memory     Decoded until its operands came back from memory
+ *   execute    Gathered until written back, less write back back pressure
+ *   write_back Executor waiting for the write back stage to take it
+ * Instructions overlap in a pipeline, so the cycles of all instructions add up to more than the
+ * run took. An empty file name disables the profile.
+ */
+class PcProfile {
+public:
+
+    explicit PcProfile(std::string file) : m_file(std::move(file)) {}
+
+    [[nodiscard]] bool IsEnabled() const noexcept { return !m_file.empty(); }
+
+    /**
+     * Attribute the cycles of a written back instruction to its address
+     */
+    void Retire(const Instruction& instruction) {
+        if (!IsEnabled()) {
+            return;
+        }
+        auto const& timestamps = instruction.timestamps;
+        auto& entry = m_entries[instruction.address];
+        ++entry.retired;
+        entry.fetch += timestamps.stalled - timestamps.fetched;
+        entry.hazard += timestamps.decoded - timestamps.stalled;
+        entry.memory += timestamps.gathered - timestamps.decoded;
+        entry.execute += timestamps.blocked - timestamps.gathered + timestamps.written_back - timestamps.executed;
+        entry.write_back += timestamps.executed - timestamps.blocked;
+        entry.opcode = instruction.opcode;
+        entry.size = static_cast<uint8_t>(1 + std::count_if(instruction.operands.begin(), instruction.operands.end(),
+                                                            [](const Operand& operand) {
+            return operand.type == Operand::Type::CONSTANT;
+        }));
+    }
+
+    /**
+     * Write the profile out hottest address first, does nothing if the profile is disabled
+     * @param memory Program memory for the disassembly, instructions only get their mnemonic without it.
+     * Instructions widened by EXTEND prefixes show the fields of their own word.
+     * @return False if the profile could not be written
+     */
+    bool Write(hestia::IMemory* memory) const {
+        if (!IsEnabled()) {
+            return true;
+        }
+        auto output = std::fopen(m_file.c_str(), "w");
+        if (output == nullptr) {
+            return false;
+        }
+        std::vector<std::pair<uint64_t, const Entry*>> sorted;
+        uint64_t total = 0;
+        for (auto const& entry : m_entries) {
+            sorted.emplace_back(entry.first, &entry.second);
+            total += entry.second.Total();
+        }
+        std::sort(sorted.begin(), sorted.end(), [](const auto& a, const auto& b) {
+            return a.second->Total() != b.second->Total() ? a.second->Total() > b.second->Total() : a.first < b.first;
+        });
+
+        std::fprintf(output, "# Instruction cycles per address, overlapping between instructions in flight\n");
+        std::fprintf(output, "%12s %7s %10s %10s %10s %10s %10s %10s %10s  %s\n", "cycles", "%", "retired", "fetch",
+                     "hazard", "memory", "execute", "write_back", "address", "instruction");
+        for (auto const& line : sorted) {
+            auto const& entry = *line.second;
+            std::fprintf(output, "%12" PRIu64 " %7.2f %10" PRIu64 " %10" PRIu64 " %10" PRIu64 " %10" PRIu64 " %10" PRIu64 " %10" PRIu64 " %10" PRIu64 "  %s\n", entry.Total(),
+                         total == 0 ? 0.0 : 100.0 * static_cast<double>(entry.Total()) / static_cast<double>(total),
+                         entry.retired, entry.fetch, entry.hazard, entry.memory, entry.execute, entry.write_back,
+                         line.first, Disassemble(memory, line.first, entry).c_str());
+        }
+        return std::fclose(output) == 0;
+    }
+
+private:
+
+    struct Entry {
+        uint64_t retired = 0;
+        uint64_t fetch = 0;
+        uint64_t hazard = 0;
+        uint64_t memory = 0;
+        uint64_t execute = 0;
+        uint64_t write_back = 0;
+        Opcode opcode = Opcode::ENDPRGM;
+        uint8_t size = 1; /*!< Words of the instruction including its constants >*/
+
+        [[nodiscard]] uint64_t Total() const noexcept { return fetch + hazard + memory + execute + write_back; }
+    };
+
+    static std::string Disassemble(hestia::IMemory* memory, uint64_t address, const Entry& entry) {
+        if (memory == nullptr) {
+            return to_string(entry.opcode);
+        }
+        auto text = Assembler::Disassemble(memory->Get(address, entry.size), address);
+        // One line of "    <instruction> ; <address>\n", only the instruction is wanted
+        auto begin = text.find_first_not_of(' ');
+        auto end = text.find(" ;");
+        return begin == std::string::npos || end == std::string::npos ? text : text.substr(begin, end - begin);
+    }
+
+    const std::string m_file;
+    std::unordered_map<uint64_t, Entry> m_entries; /*!< Keyed by the address of the instruction word >*/
+};
+
+#endif //FIRST_SOC_TIMING_DEVICES_PC_PROFILE_H
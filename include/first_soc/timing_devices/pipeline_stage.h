@@ -1,8 +1,16 @@
 #ifndef FIRST_SOC_TIMING_DEVICES_PIPELINE_STAGE_H
 #define FIRST_SOC_TIMING_DEVICES_PIPELINE_STAGE_H
 
+#include <timing/cycle.h>
+
 #include <hestia/connection/internal_connection.h>
+#include <hestia/counter/counter.h>
 
+/**
+ * Single entry connection between two phases of a processor. Keeps track of how many
+ * cycles it was holding a transaction so stage utilization can be derived from
+ * occupied_cycles / elapsed cycles.
+ */
 template<typename Transaction>
 class PipelineStage : public hestia::InternalConnection<Transaction> {
 public:
@@ -13,13 +21,34 @@ public:
     PipelineStage(const std::string& name, const hestia::Manageable* owner, const hestia::Init& init) :
             hestia::Manageable(hestia::FrameworkType::INTERNAL_CONNECTION, CreateName(owner, name) + ".pipeline_stage"),
             hestia::IActionable(init),
-            hestia::InternalConnection<Transaction>(owner, CreateInit(init, owner, name)) {}
+            hestia::InternalConnection<Transaction>(owner, CreateInit(init, owner, name)),
+            m_stage_init(init),
+            m_occupied_cycles("occupied_cycles", this, init),
+            m_transactions("transactions", this, init) {}
 
     using hestia::Manageable::GetName;
 
     using hestia::InternalConnection<Transaction>::GetCapacity;
 
     bool Validate() const noexcept override { return GetCapacity() == 1; }
+
+    void Write(const Transaction& transaction) {
+        m_occupied_since = CurrentCycle(m_stage_init);
+        ++m_transactions;
+        hestia::InternalConnection<Transaction>::Write(transaction);
+    }
+
+    Transaction Read() {
+        m_occupied_cycles += CurrentCycle(m_stage_init) - m_occupied_since;
+        return hestia::InternalConnection<Transaction>::Read();
+    }
+
+private:
+    const hestia::Init& m_stage_init;
+    uint64_t m_occupied_since = 0;
+
+    hestia::Counter m_occupied_cycles; /*!< Cycles a transaction was held in the stage >*/
+    hestia::Counter m_transactions; /*!< Transactions that passed through the stage >*/
 };
 
 #endif //FIRST_SOC_TIMING_DEVICES_PIPELINE_STAGE_H
@@ -0,0 +1,117 @@
+#ifndef FIRST_SOC_TIMING_DEVICES_PIPELINE_TRACE_H
+#define FIRST_SOC_TIMING_DEVICES_PIPELINE_TRACE_H
+
+#include "functional/transactions/instruction.h"
+
+#include <trace/chrome_trace.h>
+
+#include <array>
+#include <string>
+#include <utility>
+
+/**
+ * Records the lifetime of every instruction through the fetcher, decoder, executor and write back
+ * stages plus the intervals each stage spent back pressured. Events are buffered and only written
+ * out to a Chrome / Perfetto trace when Write is called. An empty file name disables the trace.
+ */
+class PipelineTrace {
+public:
+
+    /**
+     * Every place a pipelined processor can be back pressured, each gets its own track
+     */
+    enum class BackPressure : uint8_t {
+        FETCHER = 0,           // Fetcher stage full
+        INSTRUCTION_FETCH = 1, // Instruction request port full
+        DECODER = 2,           // Decoder stage full
+        EXECUTOR = 3,          // Executor stage full
+        OPERAND = 4,           // Data request port full while requesting operands
+        WRITE_BACK = 5,        // Write back stage full
+        WRITE_BACK_REQUEST = 6 // Data request port full while writing back
+    };
+
+    PipelineTrace(const std::string& name, std::string file) :
+            m_file(std::move(file)),
+            m_trace(name) {
+        if (!IsEnabled()) {
+            return;
+        }
+        m_fetcher = m_trace.AddTrack("fetcher");
+        m_decoder = m_trace.AddTrack("decoder");
+        m_executor = m_trace.AddTrack("executor");
+        m_write_back = m_trace.AddTrack("write_back");
+        const char* back_pressure_names[NUM_BACK_PRESSURES] = {
+                "fetcher_back_pressure", "instruction_fetch_back_pressure", "decoder_back_pressure",
+                "executor_back_pressure", "operand_back_pressure", "write_back_back_pressure",
+                "write_back_request_back_pressure"};
+        for (size_t i = 0; i < NUM_BACK_PRESSURES; i++) {
+            m_back_pressure_tracks[i] = m_trace.AddTrack(back_pressure_names[i]);
+        }
+        m_stalled = m_trace.AddName("stalled");
+        for (auto const& detail : GetDetails()) {
+            m_opcode_names[static_cast<uint8_t>(detail.first)] = m_trace.AddName(to_string(detail.first));
+        }
+        m_trace.Reserve(1u << 16u);
+    }
+
+    [[nodiscard]] bool IsEnabled() const noexcept { return !m_file.empty(); }
+
+    /**
+     * Record the phases of a written back instruction
+     */
+    void Retire(const Instruction& instruction) {
+        if (!IsEnabled()) {
+            return;
+        }
+        auto const& timestamps = instruction.timestamps;
+        auto name = m_opcode_names[static_cast<uint8_t>(instruction.opcode)];
+        m_trace.Complete(m_fetcher, name, timestamps.fetched, timestamps.returned, m_retired);
+        m_trace.Complete(m_decoder, name, timestamps.returned, timestamps.decoded, m_retired);
+        m_trace.Complete(m_executor, name, timestamps.decoded, timestamps.executed, m_retired);
+        m_trace.Complete(m_write_back, name, timestamps.executed, timestamps.written_back, m_retired);
+        ++m_retired;
+    }
+
+    /**
+     * Track whether a source is currently back pressured, opening or closing its interval
+     */
+    void BackPressured(BackPressure source, bool back_pressured, uint64_t cycle) {
+        if (!IsEnabled()) {
+            return;
+        }
+        auto track = m_back_pressure_tracks[static_cast<size_t>(source)];
+        if (back_pressured) {
+            m_trace.Begin(track, cycle);
+        } else {
+            m_trace.End(track, m_stalled, cycle);
+        }
+    }
+
+    /**
+     * Write the trace out, does nothing if the trace is disabled
+     * @return False if the trace could not be written
+     */
+    bool Write() const {
+        return !IsEnabled() || m_trace.Write(m_file);
+    }
+
+private:
+
+    static constexpr size_t NUM_BACK_PRESSURES = 7;
+
+    const std::string m_file;
+    ChromeTrace m_trace;
+
+    ChromeTrace::Track m_fetcher = 0;
+    ChromeTrace::Track m_decoder = 0;
+    ChromeTrace::Track m_executor = 0;
+    ChromeTrace::Track m_write_back = 0;
+    std::array<ChromeTrace::Track, NUM_BACK_PRESSURES> m_back_pressure_tracks{};
+
+    ChromeTrace::Name m_stalled = 0;
+    std::array<ChromeTrace::Name, 256> m_opcode_names{};
+
+    uint64_t m_retired = 0;
+};
+
+#endif //FIRST_SOC_TIMING_DEVICES_PIPELINE_TRACE_H
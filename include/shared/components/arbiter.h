@@ -0,0 +1,156 @@
+#ifndef SHARED_COMPONENTS_ARBITER_H
+#define SHARED_COMPONENTS_ARBITER_H
+
+#include <hestia/component/component_base.h>
+#include <hestia/connection/transaction_handler.h>
+#include <hestia/counter/counter.h>
+#include <hestia/port/read_port.h>
+#include <hestia/port/write_port.h>
+
+#include <deque>
+#include <functional>
+#include <string>
+
+/**
+ * Distributes everything arriving on its "in" port, which any number of producers may connect to,
+ * over the ports "out0" to "out<num_outputs - 1>". The "policy" parameter picks the output:
+ *  - round_robin: the next writeable output after the last one used
+ *  - least_loaded: the writeable output that has been sent the fewest transactions
+ *  - hash: always the same output for the same transaction, waits for it when it is full
+ * Every link counts the transactions sent over it and the times it was wanted but full.
+ */
+template<typename T>
+class Arbiter : public hestia::ComponentBase {
+public:
+
+    enum class Policy : uint8_t {
+        ROUND_ROBIN = 0,
+        LEAST_LOADED = 1,
+        HASH = 2,
+        INVALID = 3
+    };
+
+    explicit Arbiter(const hestia::ComponentInit& init) :
+            hestia::Manageable(hestia::FrameworkType::COMPONENT, init.name),
+            hestia::ComponentBase(init),
+            // Ports
+            m_in(CreatePortInit("in")),
+            // Handlers
+            m_route_handler("route_handler", this, m_init),
+            // Parameters
+            m_policy(ToPolicy(GetParam("policy"))) {
+
+        auto num_outputs = GetUintParam("num_outputs");
+        for (uint64_t i = 0; i < num_outputs; i++) {
+            auto name = "out" + std::to_string(i);
+            m_outputs.emplace_back(CreatePortInit(name));
+            m_links.emplace_back("link" + std::to_string(i) + ".", this, m_init);
+        }
+
+        m_route_handler.SetHandler(m_init, std::bind(&Arbiter::Route, this));
+        m_route_handler << m_in;
+    }
+
+    [[nodiscard]] bool Validate() const noexcept override {
+        return m_policy != Policy::INVALID && !m_outputs.empty();
+    }
+
+private:
+
+    static Policy ToPolicy(const std::string& name) {
+        if (name.empty() || name == "round_robin") {
+            return Policy::ROUND_ROBIN;
+        } else if (name == "least_loaded") {
+            return Policy::LEAST_LOADED;
+        } else if (name == "hash") {
+            return Policy::HASH;
+        }
+        return Policy::INVALID;
+    }
+
+    /**
+     * Called when a transaction arrives or a full output has room again
+     */
+    void Route() {
+        while (m_has_pending || m_in.ReadValid()) {
+            if (!m_has_pending) {
+                m_pending = m_in.Read();
+                m_has_pending = true;
+            }
+            size_t output = 0;
+            if (!Select(output)) {
+                return;
+            }
+            m_outputs[output].Write(m_pending);
+            ++m_links[output].transactions;
+            ++m_links[output].sent;
+            m_has_pending = false;
+            m_next = (output + 1) % m_outputs.size();
+        }
+    }
+
+    /**
+     * Pick the output for the pending transaction, or ask to be called again once it can go
+     * @return False if the pending transaction has to wait
+     */
+    bool Select(size_t& output) {
+        if (m_policy == Policy::HASH) {
+            // Multiplicative mix so hashes that are the value itself still spread over the outputs
+            output = static_cast<size_t>((std::hash<T>{}(m_pending) * 0x9E3779B97F4A7C15ull) >> 32u) % m_outputs.size();
+            if (m_outputs[output].WriteValid()) {
+                return true;
+            }
+            ++m_links[output].blocked;
+            m_outputs[output].NotifyOnWriteable(m_route_handler.GetId());
+            return false;
+        }
+        bool found = false;
+        for (size_t offset = 0; offset < m_outputs.size(); offset++) {
+            auto index = (m_next + offset) % m_outputs.size();
+            if (!m_outputs[index].WriteValid()) {
+                continue;
+            }
+            if (!found || (m_policy == Policy::LEAST_LOADED && m_links[index].sent < m_links[output].sent)) {
+                output = index;
+                found = true;
+            }
+            if (m_policy == Policy::ROUND_ROBIN) {
+                break;
+            }
+        }
+        if (!found) {
+            // Every output is full, whichever frees up first takes the transaction
+            for (size_t index = 0; index < m_outputs.size(); index++) {
+                ++m_links[index].blocked;
+                m_outputs[index].NotifyOnWriteable(m_route_handler.GetId());
+            }
+        }
+        return found;
+    }
+
+    struct Link {
+        uint64_t sent = 0;           /*!< Same as transactions, counters cannot be read back >*/
+        hestia::Counter transactions; /*!< Transactions sent over the link >*/
+        hestia::Counter blocked;      /*!< Times the link was wanted while full >*/
+
+        Link(const std::string& name, hestia::Manageable* owner, const hestia::Init& init) :
+                transactions(name + "transactions", owner, init),
+                blocked(name + "blocked", owner, init) {}
+    };
+
+    // Ports
+    hestia::ReadPort<T> m_in;
+    std::deque<hestia::WritePort<T>> m_outputs;
+
+    // Handlers
+    hestia::TransactionHandler m_route_handler;
+
+    const Policy m_policy;
+
+    std::deque<Link> m_links;
+    T m_pending{};              /*!< Read from in but not yet routed >*/
+    bool m_has_pending = false;
+    size_t m_next = 0;          /*!< Output after the one used last >*/
+};
+
+#endif //SHARED_COMPONENTS_ARBITER_H
@@ -0,0 +1,43 @@
+#ifndef SHARED_COMPONENTS_CHANNEL_RECEIVER_H
+#define SHARED_COMPONENTS_CHANNEL_RECEIVER_H
+
+#include "parallel/channel.h"
+#include "timing/cycle.h"
+
+#include <hestia/toolbox/components/producer.h>
+
+#include <cassert>
+
+/**
+ * Receiving end of a Channel. A transaction is written to the "out" port once `latency` cycles
+ * have passed since it was sent, never earlier, so what this partition sees does not depend on
+ * how far ahead the sending thread happens to be.
+ */
+template<typename T>
+class ChannelReceiver : public hestia::ProducerComponent<T> {
+public:
+    explicit ChannelReceiver(const hestia::ComponentInit& init) :
+            hestia::Manageable(hestia::FrameworkType::COMPONENT, init.name),
+            hestia::ProducerComponent<T>("out", init),
+            // Parameters
+            m_channel(ChannelRegistry::Instance().Get<T>(this->GetParam("channel"))) {
+        assert(m_channel != nullptr);
+    }
+
+    [[nodiscard]] bool HasWork() const noexcept override {
+        auto message = m_channel->queue.Front();
+        return message != nullptr && message->cycle + m_channel->latency <= CurrentCycle(this->m_init);
+    }
+
+    T Produce() noexcept override {
+        auto message = m_channel->queue.Front();
+        auto transaction = std::move(message->transaction);
+        m_channel->queue.Pop();
+        return transaction;
+    }
+
+private:
+    Channel<T>* m_channel;
+};
+
+#endif //SHARED_COMPONENTS_CHANNEL_RECEIVER_H
@@ -0,0 +1,35 @@
+#ifndef SHARED_COMPONENTS_CHANNEL_SENDER_H
+#define SHARED_COMPONENTS_CHANNEL_SENDER_H
+
+#include "parallel/channel.h"
+#include "timing/cycle.h"
+
+#include <hestia/toolbox/components/consumer.h>
+
+#include <cassert>
+
+/**
+ * Sending end of a Channel. Everything read from the "in" port is stamped with the current cycle
+ * and handed to the partition holding the matching ChannelReceiver. The channel is picked by the
+ * "channel" parameter and must exist before the component is created.
+ */
+template<typename T>
+class ChannelSender : public hestia::ConsumerComponent<T> {
+public:
+    explicit ChannelSender(const hestia::ComponentInit& init) :
+            hestia::Manageable(hestia::FrameworkType::COMPONENT, init.name),
+            hestia::ConsumerComponent<T>("in", init),
+            // Parameters
+            m_channel(ChannelRegistry::Instance().Get<T>(this->GetParam("channel"))) {
+        assert(m_channel != nullptr);
+    }
+
+    void Process(T transaction) noexcept override {
+        m_channel->queue.Push({CurrentCycle(this->m_init), std::move(transaction)});
+    }
+
+private:
+    Channel<T>* m_channel;
+};
+
+#endif //SHARED_COMPONENTS_CHANNEL_SENDER_H
@@ -0,0 +1,25 @@
+#ifndef SHARED_COMPONENTS_MEMORY_VIEW_H
+#define SHARED_COMPONENTS_MEMORY_VIEW_H
+
+#include "python/test_bench_views.h"
+
+#include <hestia/component/component_base.h>
+#include <hestia/memory/memory_manager.h>
+
+/**
+ * Has no ports, only makes the memory named by its "memory_name" parameter readable from Python
+ * through ReadMemory. Add one per memory that should be inspected.
+ */
+class MemoryView : public hestia::ComponentBase {
+public:
+    explicit MemoryView(const hestia::ComponentInit& init) :
+            hestia::Manageable(hestia::FrameworkType::COMPONENT, init.name),
+            hestia::ComponentBase(init) {
+        auto memory_name = GetParam("memory_name");
+        RegisterViewMemory(memory_name, m_init.memories->GetMemory(memory_name));
+    }
+
+    [[nodiscard]] bool Validate() const noexcept override { return true; }
+};
+
+#endif //SHARED_COMPONENTS_MEMORY_VIEW_H
@@ -1,54 +1,134 @@
 #ifndef CONSUMER_H
 #define CONSUMER_H
 
+#include <hestia/component/component_base.h>
+#include <hestia/connection/transaction_handler.h>
 #include <hestia/counter/counter.h>
-#include <hestia/toolbox/components/consumer.h>
+#include <hestia/port/read_port.h>
+
+#include <cstdint>
+#include <vector>
 
 /**
  * Consumes numbers from it's "in" port. Will provide counters for odd, even, prime numbers
- * consumed.
+ * consumed. Everything readable is drained and classified as one batch per activation.
  */
-class NumberConsumer : public hestia::ConsumerComponent<uint32_t> {
+class NumberConsumer : public hestia::ComponentBase {
 public:
     explicit NumberConsumer(const hestia::ComponentInit& init) :
             hestia::Manageable(hestia::FrameworkType::COMPONENT, init.name),
-            hestia::ConsumerComponent<uint32_t>("in", init), // My input port is named "in"
+            hestia::ComponentBase(init),
+            // Ports
+            m_in(CreatePortInit("in")), // My input port is named "in"
+            // Handlers
+            m_in_handler("in_handler", this, m_init),
             // Counters
             m_even("even", this, m_init),
             m_odd("odd", this, m_init),
-            m_prime("prime", this, m_init) {}
+            m_prime("prime", this, m_init) {
+
+        m_in_handler.SetHandler(m_init, std::bind(&NumberConsumer::Consume, this));
+        m_in_handler << m_in;
+    }
+
+    [[nodiscard]] bool Validate() const noexcept override { return true; }
+
+    /**
+     * Will be called anytime that my input port has transactions available, reads all of them
+     */
+    void Consume() {
+        m_batch.clear();
+        while (m_in.ReadValid()) {
+            m_batch.push_back(m_in.Read());
+        }
+        Classify(m_batch.data(), m_batch.size());
+    }
 
     /**
-     * Will be called anytime that my input port has transactions available
-     * and bandwidth for me to read another transaction.
+     * Count the even, odd and prime numbers of a batch, counters are updated once per batch
      */
-    void Process(uint32_t transaction) noexcept override {
-        if(IsEven(transaction)) {
-            ++m_even;
-        } else {
-            ++m_odd;
-            if (IsPrime(transaction)) {
-                ++m_prime;
+    void Classify(const uint32_t* numbers, size_t size) noexcept {
+        // Branch free so the compiler vectorises the parity count
+        uint64_t odd = 0;
+        for (size_t i = 0; i < size; i++) {
+            odd += numbers[i] & 1u;
+        }
+        // Even numbers are never counted as prime
+        uint64_t prime = 0;
+        for (size_t i = 0; i < size; i++) {
+            if ((numbers[i] & 1u) != 0 && IsPrime(numbers[i])) {
+                ++prime;
             }
         }
+        m_even += size - odd;
+        m_odd += odd;
+        m_prime += prime;
+    }
 
+    /**
+     * Deterministic for every 32 bit number: trial division by the primes below 64, then
+     * Miller-Rabin with bases 2, 7 and 61 which has no strong pseudoprimes below 2^32
+     */
+    static bool IsPrime(uint32_t num) noexcept {
+        if (num < 2) {
+            return false;
+        }
+        for (uint32_t divisor : {2u, 3u, 5u, 7u, 11u, 13u, 17u, 19u, 23u, 29u, 31u, 37u, 41u, 43u, 47u, 53u, 59u, 61u}) {
+            if (num % divisor == 0) {
+                return num == divisor;
+            }
+        }
+        // No factor below 64 so anything below 64 * 64 is prime
+        if (num < 64 * 64) {
+            return true;
+        }
+        uint32_t d = num - 1;
+        auto shift = __builtin_ctz(d);
+        d >>= shift;
+        for (uint64_t base : {2u, 7u, 61u}) {
+            if (!IsStrongProbablePrime(num, base, d, shift)) {
+                return false;
+            }
+        }
+        return true;
     }
 
 private:
 
-    static bool IsEven(uint32_t num) noexcept { return num % 2 == 0; }
-
-    static bool IsPrime(uint32_t num) noexcept {
-        if (num < 2) return false;
-        for(uint32_t i = 3; ( i * i ) <= num; i += 2) {
-            if(num % i == 0 ) { return false; }
+    /**
+     * Miller-Rabin round for num - 1 = d * 2^shift with d odd, products fit 64 bits as num < 2^32
+     */
+    static bool IsStrongProbablePrime(uint64_t num, uint64_t base, uint64_t d, int shift) noexcept {
+        uint64_t x = 1;
+        for (base %= num; d != 0; d >>= 1) {
+            if (d & 1u) {
+                x = x * base % num;
+            }
+            base = base * base % num;
         }
-        return true;
+        if (x == 1 || x == num - 1) {
+            return true;
+        }
+        for (int i = 1; i < shift; i++) {
+            x = x * x % num;
+            if (x == num - 1) {
+                return true;
+            }
+        }
+        return false;
     }
 
+    // Ports
+    hestia::ReadPort<uint32_t> m_in;
+
+    // Handlers
+    hestia::TransactionHandler m_in_handler;
+
+    std::vector<uint32_t> m_batch; /*!< Reused between activations >*/
+
     hestia::Counter m_even; /*!< Incremented anytime a even number is consumed >*/
     hestia::Counter m_odd; /*!< Incremented anytime a odd number is consumed >*/
     hestia::Counter m_prime; /*!< Incremented anytime a prime number is consumed >*/
 };
 
-#endif //CONSUMER_H
\ No newline at end of file
+#endif //CONSUMER_H
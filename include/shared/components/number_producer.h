@@ -1,50 +1,172 @@
 #ifndef PRODUCER_H
 #define PRODUCER_H
 
-#include <hestia/toolbox/components/producer.h>
+#include <hestia/component/component_base.h>
+#include <hestia/connection/transaction_handler.h>
+#include <hestia/port/write_port.h>
 
-#include <random>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <string>
 
 /**
  * Simple random number generator producer. Can be configured at run time to
- * generate random numbers between a range as well as the amount of numbers
- * to produce.
+ * generate numbers between a range as well as the amount of numbers
+ * to produce. Numbers are generated a block at a time and written out until
+ * the "out" port has no more bandwidth.
+ *
+ * Parameters: num_transactions, min_number, max_number, distribution (uniform,
+ * zipf or sequential, empty for uniform), seed (empty for 0) and zipf_exponent
+ * (only read by zipf, empty for 1).
  */
-class NumberProducer : public hestia::ProducerComponent<uint32_t> {
+class NumberProducer : public hestia::ComponentBase {
 public:
+
+    enum class Distribution : uint8_t {
+        UNIFORM = 0,    // Every number in the range equally likely
+        ZIPF = 1,       // min_number most likely, falling off with the rank from there
+        SEQUENTIAL = 2, // min_number to max_number and around again
+        INVALID = 3
+    };
+
+    static constexpr size_t BLOCK_SIZE = 256;
+
     explicit NumberProducer(const hestia::ComponentInit &init) :
             Manageable(hestia::FrameworkType::COMPONENT, init.name),
-            hestia::ProducerComponent<uint32_t>("out", init), // My output port is named "out"
+            hestia::ComponentBase(init),
+            // Ports
+            m_out(CreatePortInit("out")), // My output port is named "out"
+            // Handlers
+            m_out_handler("out_handler", this, m_init),
             // Parameters
             m_num_transactions_remaining(GetUintParam("num_transactions")),
-            m_number_generator(GetUintParam("min_number"),
-                               GetUintParam("max_number")) {}
+            m_min(GetUintParam("min_number")),
+            m_range(GetUintParam("max_number") - m_min + 1),
+            m_distribution(ToDistribution(GetParam("distribution"))) {
+
+        auto seed = GetParam("seed");
+        m_state = seed.empty() ? 0 : std::stoull(seed);
+        if (m_distribution == Distribution::ZIPF) {
+            auto exponent = GetParam("zipf_exponent");
+            m_zipf_exponent = exponent.empty() ? 1.0 : std::stod(exponent);
+        }
+
+        m_out_handler.SetHandler(m_init, std::bind(&NumberProducer::Produce, this));
+    }
+
+    [[nodiscard]] bool Validate() const noexcept override {
+        return m_distribution != Distribution::INVALID && m_range != 0 && m_range <= (uint64_t{1} << 32u);
+    }
+
+    void Setup() noexcept override {
+        Produce();
+    }
 
     /**
-     * Function to let the base class know that I still have work to generate.
+     * Called at setup and anytime that my output port has room again, writes as many numbers as
+     * the port takes
      */
-    [[nodiscard]] bool HasWork() const noexcept override {
-        return m_num_transactions_remaining > 0;
+    void Produce() {
+        while (m_num_transactions_remaining > 0 && m_out.WriteValid()) {
+            if (m_next == m_block.size()) {
+                Refill();
+            }
+            m_out.Write(m_block[m_next++]);
+            --m_num_transactions_remaining;
+        }
+        if (m_num_transactions_remaining > 0) {
+            m_out.NotifyOnWriteable(m_out_handler.GetId());
+        }
+    }
+
+private:
+
+    static Distribution ToDistribution(const std::string& name) {
+        if (name.empty() || name == "uniform") {
+            return Distribution::UNIFORM;
+        } else if (name == "zipf") {
+            return Distribution::ZIPF;
+        } else if (name == "sequential") {
+            return Distribution::SEQUENTIAL;
+        }
+        return Distribution::INVALID;
     }
 
     /**
-     * Will be called anytime that my output port has room and bandwidth for
-     * me to produce another transaction. In this case the transaction will
-     * be a random number in the range of the min / max parameters defined
-     * at run time.
+     * SplitMix64 output for the i-th number after the current state. Each number only depends on
+     * its index so a block fill has no loop carried dependency and vectorises.
      */
-    uint32_t Produce() noexcept override {
-        --m_num_transactions_remaining;
-        return m_number_generator(m_rng);
+    uint64_t Random(size_t i) const noexcept {
+        uint64_t z = m_state + (i + 1) * 0x9E3779B97F4A7C15ull;
+        z = (z ^ (z >> 30u)) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ (z >> 27u)) * 0x94D049BB133111EBull;
+        return z ^ (z >> 31u);
     }
 
-private:
+    /**
+     * Rank in [0, range) drawn from a continuous approximation of Zipf's law, by inverting the
+     * CDF of x^-exponent over [1, range + 1)
+     * @param u Uniform in [0, 1)
+     */
+    uint64_t ZipfRank(double u) const noexcept {
+        const double n = static_cast<double>(m_range) + 1.0;
+        double x;
+        if (m_zipf_exponent == 1.0) {
+            x = std::pow(n, u);
+        } else {
+            const double power = 1.0 - m_zipf_exponent;
+            x = std::pow(1.0 + u * (std::pow(n, power) - 1.0), 1.0 / power);
+        }
+        auto rank = static_cast<uint64_t>(x) - 1;
+        return rank < m_range ? rank : m_range - 1;
+    }
+
+    void Refill() noexcept {
+        switch (m_distribution) {
+            case Distribution::UNIFORM:
+                // Multiply shift maps the top 32 bits onto the range without a division
+                for (size_t i = 0; i < BLOCK_SIZE; i++) {
+                    m_block[i] = static_cast<uint32_t>(m_min + (((Random(i) >> 32u) * m_range) >> 32u));
+                }
+                break;
+            case Distribution::ZIPF:
+                for (size_t i = 0; i < BLOCK_SIZE; i++) {
+                    auto u = static_cast<double>(Random(i) >> 11u) * 0x1.0p-53;
+                    m_block[i] = static_cast<uint32_t>(m_min + ZipfRank(u));
+                }
+                break;
+            case Distribution::SEQUENTIAL:
+                for (size_t i = 0; i < BLOCK_SIZE; i++) {
+                    m_block[i] = static_cast<uint32_t>(m_min + (m_state + i) % m_range);
+                }
+                m_state = (m_state + BLOCK_SIZE) % m_range;
+                m_next = 0;
+                return;
+            case Distribution::INVALID:
+                break;
+        }
+        m_state += BLOCK_SIZE * 0x9E3779B97F4A7C15ull;
+        m_next = 0;
+    }
+
+    // Ports
+    hestia::WritePort<uint32_t> m_out;
+
+    // Handlers
+    hestia::TransactionHandler m_out_handler;
+
     uint64_t m_num_transactions_remaining;
+    const uint64_t m_min;
+    const uint64_t m_range;                 /*!< Numbers between min and max inclusive >*/
+    const Distribution m_distribution;
+    double m_zipf_exponent = 1.0;
 
     // Output Generators
-    std::mt19937 m_rng{{}};
-    std::uniform_int_distribution<std::mt19937::result_type> m_number_generator;
+    uint64_t m_state = 0;                   /*!< SplitMix64 state, the next offset for sequential >*/
+    std::array<uint32_t, BLOCK_SIZE> m_block{};
+    size_t m_next = BLOCK_SIZE;             /*!< Next number of the block to write >*/
 
 };
 
-#endif //PRODUCER_H
\ No newline at end of file
+#endif //PRODUCER_H
@@ -0,0 +1,58 @@
+#ifndef SHARED_COUNTER_STORE_COLUMNAR_FORMAT_H
+#define SHARED_COUNTER_STORE_COLUMNAR_FORMAT_H
+
+#include <cstdint>
+
+/**
+ * On disk layout of a columnar counter store.
+ *
+ * | FileHeader | Schema | Block 0 | Block 1 | ... | Block Index |
+ *
+ * The schema is num_columns entries of (uint16_t length, name bytes) padded to 8 bytes.
+ * Column 0 is always the sample cycle, the remaining columns are counters in schema order.
+ * Every block holds rows_per_block rows (the last one may hold less) stored column by
+ * column, each column starting on an 8 byte boundary so RAW columns can be read straight
+ * out of a mapping. The block index is one BlockEntry followed by num_columns column
+ * offsets (relative to the start of the block) per block.
+ */
+namespace counter_store {
+
+static constexpr char MAGIC[8] = {'H', 'C', 'S', 'T', 'O', 'R', 'E', '\0'};
+static constexpr uint32_t VERSION = 1;
+
+/**
+ * How every column in the file is stored
+ */
+enum class Encoding : uint32_t {
+    RAW = 0,         // Fixed 64 bit values, can be used in place from a mapping
+    VARINT = 1,      // LEB128 encoded values
+    DELTA_VARINT = 2 // LEB128 encoded zigzag deltas from the previous row in the block
+};
+
+struct FileHeader {
+    char     magic[8];
+    uint32_t version;
+    Encoding encoding;
+    uint32_t num_columns;    // Including the cycle column
+    uint32_t rows_per_block;
+    uint64_t num_rows;       // Patched when the store is closed
+    uint64_t num_blocks;     // Patched when the store is closed
+    uint64_t index_offset;   // Patched when the store is closed
+    uint64_t reserved;
+};
+
+struct BlockEntry {
+    uint64_t offset;   // File offset of the block
+    uint64_t size;     // Size in bytes of the block
+    uint32_t num_rows;
+    uint32_t reserved;
+};
+
+static_assert(sizeof(FileHeader) == 56, "FileHeader layout must stay stable");
+static_assert(sizeof(BlockEntry) == 24, "BlockEntry layout must stay stable");
+
+inline uint64_t AlignTo8(uint64_t value) noexcept { return (value + 7u) & ~static_cast<uint64_t>(7u); }
+
+} // namespace counter_store
+
+#endif //SHARED_COUNTER_STORE_COLUMNAR_FORMAT_H
@@ -0,0 +1,83 @@
+#ifndef SHARED_COUNTER_STORE_COLUMNAR_READER_H
+#define SHARED_COUNTER_STORE_COLUMNAR_READER_H
+
+#include "counter_store/columnar_format.h"
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace counter_store {
+
+/**
+ * Memory maps a columnar counter store and gives access to its columns. RAW stores can be
+ * read in place, other encodings are decoded a block at a time.
+ */
+class ColumnarReader {
+public:
+
+    explicit ColumnarReader(const std::string& file);
+    ~ColumnarReader();
+
+    ColumnarReader(const ColumnarReader&) = delete;
+    ColumnarReader& operator=(const ColumnarReader&) = delete;
+
+    /**
+     * @return True if the file was mapped and has a valid header, schema and block index
+     */
+    [[nodiscard]] bool IsValid() const noexcept { return m_valid; }
+
+    /**
+     * @return Names of all columns, column 0 is always "cycle"
+     */
+    [[nodiscard]] const std::vector<std::string>& GetColumns() const noexcept { return m_columns; }
+
+    /**
+     * @return Index of the named column or GetColumns().size() if there is none
+     */
+    [[nodiscard]] size_t FindColumn(const std::string& name) const noexcept;
+
+    [[nodiscard]] Encoding GetEncoding() const noexcept { return m_header.encoding; }
+    [[nodiscard]] uint64_t GetNumRows() const noexcept { return m_header.num_rows; }
+    [[nodiscard]] size_t GetNumBlocks() const noexcept { return m_blocks.size(); }
+    [[nodiscard]] uint32_t GetNumBlockRows(size_t block) const noexcept { return m_blocks[block].num_rows; }
+
+    /**
+     * Decode a single column of a single block
+     * @param block Index of the block
+     * @param column Index of the column
+     * @param values Replaced with the decoded values
+     * @return False if the block is corrupted
+     */
+    bool ReadBlock(size_t block, size_t column, std::vector<uint64_t>& values) const;
+
+    /**
+     * Decode an entire column across all blocks
+     */
+    bool ReadColumn(size_t column, std::vector<uint64_t>& values) const;
+
+    /**
+     * Access a RAW column of a block without copying it
+     * @return Pointer to GetNumBlockRows(block) values or nullptr if the store is not RAW
+     */
+    [[nodiscard]] const uint64_t* GetRawBlock(size_t block, size_t column) const noexcept;
+
+private:
+
+    bool Parse();
+    [[nodiscard]] const uint8_t* ColumnStart(size_t block, size_t column) const noexcept;
+    [[nodiscard]] const uint8_t* ColumnEnd(size_t block, size_t column) const noexcept;
+
+    const uint8_t* m_data = nullptr;
+    size_t m_size = 0;
+    bool m_valid = false;
+
+    FileHeader m_header{};
+    std::vector<std::string> m_columns;
+    std::vector<BlockEntry> m_blocks;
+    std::vector<const uint64_t*> m_column_offsets; /*!< Per block pointer into the index >*/
+};
+
+} // namespace counter_store
+
+#endif //SHARED_COUNTER_STORE_COLUMNAR_READER_H
@@ -0,0 +1,94 @@
+#ifndef SHARED_COUNTER_STORE_COLUMNAR_SAMPLER_H
+#define SHARED_COUNTER_STORE_COLUMNAR_SAMPLER_H
+
+#include "counter_store/columnar_writer.h"
+#include "counter_store/counter_source.h"
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace counter_store {
+
+/**
+ * Drop in replacement for the csv sampler. Driven from the clock loop of a test bench, every
+ * sample_rate cycles it reads all of its counters into a row of a columnar store. A sample rate of
+ * 0 only takes the final sample on Close.
+ */
+class ColumnarSampler {
+public:
+
+    ColumnarSampler(const ICounterSource& source, const std::string& file, uint64_t sample_rate,
+                    Encoding encoding = Encoding::DELTA_VARINT) :
+            m_source(source),
+            m_file(file),
+            m_sample_rate(sample_rate),
+            m_encoding(encoding) {}
+
+    /**
+     * Add a column to the sampler. All columns must be added before the first call to Clock.
+     * @param name Name of the counter, also used as the name of the column in the store
+     */
+    void AddCounter(const std::string& name) {
+        m_names.emplace_back(name);
+        m_handles.emplace_back(m_source.ResolveCounter(name));
+    }
+
+    /**
+     * Creates the store, after this no more counters can be added
+     * @return True if the store was created
+     */
+    bool Open() {
+        m_writer = std::make_unique<ColumnarWriter>(m_file, m_names, m_encoding);
+        m_row.resize(m_handles.size());
+        return m_writer->IsOpen();
+    }
+
+    /**
+     * Let the sampler know that the design has advanced to a cycle
+     */
+    void Clock(uint64_t cycle) noexcept {
+        if (m_sample_rate != 0 && cycle % m_sample_rate == 0) {
+            Sample(cycle);
+        }
+    }
+
+    /**
+     * Unconditionally take a sample at the given cycle
+     */
+    void Sample(uint64_t cycle) noexcept {
+        if (!m_writer) {
+            return;
+        }
+        m_source.ReadCounters(m_handles.data(), m_handles.size(), m_row.data());
+        m_writer->Append(cycle, m_row.data());
+    }
+
+    /**
+     * Take a final sample and finalize the store
+     * @return False if the store could not be written
+     */
+    bool Close(uint64_t cycle) noexcept {
+        if (!m_writer) {
+            return false;
+        }
+        Sample(cycle);
+        return m_writer->Close();
+    }
+
+private:
+    const ICounterSource& m_source;
+    const std::string m_file;
+    const uint64_t m_sample_rate;
+    const Encoding m_encoding;
+
+    std::vector<std::string> m_names;
+    std::vector<ICounterSource::Handle> m_handles;
+    std::vector<uint64_t> m_row;
+    std::unique_ptr<ColumnarWriter> m_writer;
+};
+
+} // namespace counter_store
+
+#endif //SHARED_COUNTER_STORE_COLUMNAR_SAMPLER_H
@@ -0,0 +1,79 @@
+#ifndef SHARED_COUNTER_STORE_COLUMNAR_WRITER_H
+#define SHARED_COUNTER_STORE_COLUMNAR_WRITER_H
+
+#include "counter_store/columnar_format.h"
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace counter_store {
+
+/**
+ * Writes rows of counter samples into a columnar binary file. Rows are buffered column major
+ * and only encoded when a block fills up, so appending a sample is a handful of stores.
+ */
+class ColumnarWriter {
+public:
+
+    /**
+     * @param file Path of the store to create
+     * @param counters Names of the counter columns, the cycle column is added implicitly
+     * @param encoding How the columns will be stored
+     * @param rows_per_block Number of rows buffered before a block gets written
+     */
+    ColumnarWriter(const std::string& file, std::vector<std::string> counters,
+                   Encoding encoding = Encoding::DELTA_VARINT, uint32_t rows_per_block = 4096);
+    ~ColumnarWriter();
+
+    ColumnarWriter(const ColumnarWriter&) = delete;
+    ColumnarWriter& operator=(const ColumnarWriter&) = delete;
+
+    /**
+     * @return True if the file was created and nothing has failed writing to it
+     */
+    [[nodiscard]] bool IsOpen() const noexcept { return m_file != nullptr && !m_failed; }
+
+    /**
+     * Append a row to the store, does nothing if the store failed to open or was closed
+     * @param cycle Cycle the sample was taken at
+     * @param values One value per counter column in the order given at construction
+     */
+    void Append(uint64_t cycle, const uint64_t* values) noexcept;
+
+    /**
+     * Flush the partial block, write the block index and finalize the header.
+     * Called automatically on destruction.
+     * @return False if the store could not be created or any write to it failed
+     */
+    bool Close() noexcept;
+
+    [[nodiscard]] size_t GetNumCounters() const noexcept { return m_num_columns - 1; }
+
+private:
+
+    void WriteSchema(const std::vector<std::string>& counters);
+    void FlushBlock() noexcept;
+    void EncodeColumn(const uint64_t* column, uint32_t num_rows);
+    void Write(const void* data, size_t size) noexcept;
+
+    std::FILE* m_file = nullptr;
+    bool m_failed = false;
+
+    FileHeader m_header{};
+    const uint32_t m_num_columns;
+    const uint32_t m_rows_per_block;
+
+    std::vector<uint64_t> m_block;        /*!< Column major buffer for the block being filled >*/
+    uint32_t m_block_rows = 0;
+    std::vector<uint8_t> m_encoded;       /*!< Scratch space for encoding a block >*/
+    std::vector<uint64_t> m_column_offsets;
+    uint64_t m_offset = 0;                /*!< Current size of the file >*/
+
+    std::vector<BlockEntry> m_blocks;
+    std::vector<uint64_t> m_block_column_offsets;
+};
+
+} // namespace counter_store
+
+#endif //SHARED_COUNTER_STORE_COLUMNAR_WRITER_H
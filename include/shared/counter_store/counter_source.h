@@ -0,0 +1,37 @@
+#ifndef SHARED_COUNTER_STORE_COUNTER_SOURCE_H
+#define SHARED_COUNTER_STORE_COUNTER_SOURCE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace counter_store {
+
+/**
+ * Where a sampler reads its counters from. Counters are looked up by name once, when they are
+ * added to the sampler, and read back through the returned handles on every sample.
+ */
+class ICounterSource {
+public:
+    using Handle = uint64_t;
+
+    virtual ~ICounterSource() = default;
+
+    /**
+     * @param name Full name of the counter
+     * @return Handle to read the counter through
+     */
+    virtual Handle ResolveCounter(const std::string& name) const = 0;
+
+    /**
+     * Read the current value of a set of counters
+     * @param handles Counters to read, as returned by ResolveCounter
+     * @param num_handles Number of counters to read
+     * @param values Receives one value per handle
+     */
+    virtual void ReadCounters(const Handle* handles, size_t num_handles, uint64_t* values) const = 0;
+};
+
+} // namespace counter_store
+
+#endif //SHARED_COUNTER_STORE_COUNTER_SOURCE_H
@@ -0,0 +1,76 @@
+#ifndef SHARED_ENCODING_VARINT_H
+#define SHARED_ENCODING_VARINT_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * Small helpers for LEB128 style variable length integers. Used by our binary
+ * counter and trace formats to keep mostly small values (deltas) small on disk.
+ */
+namespace varint {
+
+/**
+ * Maximum number of bytes a single encoded uint64_t can take
+ */
+static constexpr size_t MAX_BYTES = 10;
+
+/**
+ * Map a signed value onto an unsigned one so that small magnitudes stay small
+ */
+inline uint64_t ZigZagEncode(int64_t value) noexcept {
+    return (static_cast<uint64_t>(value) << 1u) ^ static_cast<uint64_t>(value >> 63);
+}
+
+inline int64_t ZigZagDecode(uint64_t value) noexcept {
+    return static_cast<int64_t>(value >> 1u) ^ -static_cast<int64_t>(value & 1u);
+}
+
+/**
+ * Encode a value into a raw buffer
+ * @param value The value to encode
+ * @param out Buffer with room for at least MAX_BYTES
+ * @return Number of bytes written
+ */
+inline size_t Encode(uint64_t value, uint8_t* out) noexcept {
+    size_t size = 0;
+    while (value >= 0x80u) {
+        out[size++] = static_cast<uint8_t>(value | 0x80u);
+        value >>= 7u;
+    }
+    out[size++] = static_cast<uint8_t>(value);
+    return size;
+}
+
+/**
+ * Encode a value onto the end of a byte vector
+ */
+inline void Encode(uint64_t value, std::vector<uint8_t>& out) {
+    uint8_t buffer[MAX_BYTES];
+    auto size = Encode(value, buffer);
+    out.insert(out.end(), buffer, buffer + size);
+}
+
+/**
+ * Decode a value from a raw buffer
+ * @param in Current read position, advanced past the value on success
+ * @param end End of the readable buffer
+ * @param value Decoded value
+ * @return False if the buffer ended before the value did
+ */
+inline bool Decode(const uint8_t*& in, const uint8_t* end, uint64_t& value) noexcept {
+    value = 0;
+    for (uint32_t shift = 0; in < end && shift < 64; shift += 7) {
+        auto byte = *in++;
+        value |= static_cast<uint64_t>(byte & 0x7Fu) << shift;
+        if (!(byte & 0x80u)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+} // namespace varint
+
+#endif //SHARED_ENCODING_VARINT_H
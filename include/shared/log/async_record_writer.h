@@ -0,0 +1,90 @@
+#ifndef SHARED_LOG_ASYNC_RECORD_WRITER_H
+#define SHARED_LOG_ASYNC_RECORD_WRITER_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * Fixed size binary records written to a file by a background thread. Write only copies the record
+ * into a bounded ring buffer, so the simulation thread never waits on the file. What happens when
+ * the ring is full is up to the FullPolicy. One thread may call Write.
+ *
+ * File layout:
+ * | "HRECLOG\0" | uint32_t version | uint32_t record_size | record... |
+ */
+class AsyncRecordWriter {
+public:
+
+    static constexpr uint32_t VERSION = 1;
+
+    enum class FullPolicy : uint8_t {
+        DROP = 0,  // Count the record as dropped and carry on
+        BLOCK = 1  // Wait for the background thread to make room
+    };
+
+    /**
+     * @param file File to write to, an empty name disables the writer
+     * @param record_size Bytes per record
+     * @param capacity Records the ring holds, rounded up to a power of two
+     * @param policy What Write does when the ring is full
+     */
+    AsyncRecordWriter(const std::string& file, size_t record_size, size_t capacity = 1u << 16u,
+                      FullPolicy policy = FullPolicy::BLOCK);
+    ~AsyncRecordWriter();
+
+    AsyncRecordWriter(const AsyncRecordWriter&) = delete;
+    AsyncRecordWriter& operator=(const AsyncRecordWriter&) = delete;
+
+    [[nodiscard]] bool IsEnabled() const noexcept { return m_file != nullptr; }
+
+    /**
+     * @return True if the file could not be created or writing to it failed
+     */
+    [[nodiscard]] bool HasFailed() const noexcept { return m_failed.load(std::memory_order_relaxed); }
+
+    /**
+     * Copy a record of record_size bytes into the ring
+     * @return False if the record was dropped or the writer is disabled
+     */
+    bool Write(const void* record) noexcept;
+
+    /**
+     * Write out the records left in the ring and close the file. Called automatically on destruction.
+     * @return False if the file could not be created or anything failed writing it
+     */
+    bool Close() noexcept;
+
+    /**
+     * Records accepted into the ring, some may not have reached the file yet
+     */
+    [[nodiscard]] uint64_t GetNumAccepted() const noexcept { return m_head.load(std::memory_order_relaxed); }
+    [[nodiscard]] uint64_t GetNumDropped() const noexcept { return m_num_dropped; }
+
+private:
+
+    void Drain();
+
+    const size_t m_record_size;
+    const FullPolicy m_policy;
+    size_t m_capacity = 1;
+    std::vector<uint8_t> m_buffer;
+    std::FILE* m_file = nullptr;
+
+    std::atomic<uint64_t> m_head{0}; /*!< Records written into the ring, only moved by Write >*/
+    std::atomic<uint64_t> m_tail{0}; /*!< Records written out to the file, only moved by Drain >*/
+    uint64_t m_num_dropped = 0;
+    std::atomic<bool> m_failed{false}; /*!< Also set by the background thread >*/
+
+    std::atomic<bool> m_stop{false};
+    std::mutex m_mutex;
+    std::condition_variable m_wake; /*!< Wakes the background thread early once the ring is half full >*/
+    std::thread m_thread;
+};
+
+#endif //SHARED_LOG_ASYNC_RECORD_WRITER_H
@@ -0,0 +1,103 @@
+#ifndef SHARED_LOG_EVENT_LOG_H
+#define SHARED_LOG_EVENT_LOG_H
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+/**
+ * Levels an event can be logged at. Events below EVENT_LOG_LEVEL are compiled out entirely.
+ */
+enum class EventLevel : uint8_t {
+    DEBUG = 0,
+    INFO = 1,
+    WARNING = 2
+};
+
+#ifndef EVENT_LOG_LEVEL
+#define EVENT_LOG_LEVEL 0
+#endif
+
+/**
+ * Lowest level compiled in, compared as levels rather than integers to keep -Wtype-limits quiet
+ * when it is DEBUG
+ */
+static constexpr EventLevel MIN_EVENT_LEVEL = static_cast<EventLevel>(EVENT_LOG_LEVEL);
+
+/**
+ * Log a structured event. Compiled out if the level is below EVENT_LOG_LEVEL, otherwise costs a
+ * single branch on the log being enabled. The cycle and arguments are only evaluated when enabled.
+ * Usage: LOG_EVENT(m_events, EventLevel::INFO, MyEvent::SOMETHING, cycle, arg0, arg1)
+ */
+#define LOG_EVENT(log, level, event, ...)                                                       \
+    do {                                                                                        \
+        if constexpr ((level) >= MIN_EVENT_LEVEL) {                                             \
+            if (__builtin_expect((log).IsEnabled(), 0)) {                                       \
+                (log).Record(level, static_cast<uint16_t>(event), __VA_ARGS__);                 \
+            }                                                                                   \
+        }                                                                                       \
+    } while (0)
+
+/**
+ * Binary replacement for string based logging. Events are identified by an id from an enum owned
+ * by the code doing the logging, the names of the ids are stored once in the file header. Each
+ * event is a fixed size record buffered in memory and written out in large chunks.
+ *
+ * File layout:
+ * | "HEVTLOG\0" | uint32_t version | uint32_t num_names | (uint16_t length, name bytes)... | Entry... |
+ */
+class EventLog {
+public:
+
+    static constexpr uint32_t VERSION = 1;
+
+    struct Entry {
+        uint64_t cycle;
+        uint16_t event;
+        uint8_t  level;
+        uint8_t  reserved[5];
+        uint64_t args[4];
+    };
+
+    /**
+     * @param file File to write to, an empty name disables the log
+     * @param names Name of every event id, indexed by id
+     * @param capacity Number of records buffered before they are written out
+     */
+    EventLog(const std::string& file, const std::vector<std::string>& names, size_t capacity = 1u << 14u);
+    ~EventLog();
+
+    EventLog(const EventLog&) = delete;
+    EventLog& operator=(const EventLog&) = delete;
+
+    [[nodiscard]] bool IsEnabled() const noexcept { return m_file != nullptr; }
+
+    /**
+     * @return True if the log could not be created or a write to it failed, logging stops at that point
+     */
+    [[nodiscard]] bool HasFailed() const noexcept { return m_failed; }
+
+    void Record(EventLevel level, uint16_t event, uint64_t cycle,
+                uint64_t arg0 = 0, uint64_t arg1 = 0, uint64_t arg2 = 0, uint64_t arg3 = 0) noexcept {
+        m_records.push_back({cycle, event, static_cast<uint8_t>(level), {}, {arg0, arg1, arg2, arg3}});
+        if (m_records.size() == m_capacity) {
+            Flush();
+        }
+    }
+
+    /**
+     * Write out all buffered records
+     */
+    void Flush() noexcept;
+
+private:
+    void Disable() noexcept;
+
+    std::FILE* m_file = nullptr;
+    bool m_failed = false;
+    const size_t m_capacity;
+    std::vector<Entry> m_records;
+};
+
+#endif //SHARED_LOG_EVENT_LOG_H
@@ -0,0 +1,71 @@
+#ifndef SHARED_MEMORY_TRACE_MEMORY_TRACE_FORMAT_H
+#define SHARED_MEMORY_TRACE_MEMORY_TRACE_FORMAT_H
+
+#include <cstdint>
+
+/**
+ * On disk layout of a memory address trace.
+ *
+ * | FileHeader | BlockHeader 0 | Block 0 | BlockHeader 1 | Block 1 | ...
+ *
+ * Every block is self contained so a trace can be streamed back without an index and a trace
+ * cut short still reads up to its last complete block. A record is encoded as three varints:
+ * the zigzag cycle delta, (size << 1) | type and the zigzag address delta, all deltas from the
+ * previous record of the same block. With compression a block holding the encoded records is
+ * deflated on its own, blocks that do not shrink are stored as is.
+ */
+namespace memory_trace {
+
+static constexpr char MAGIC[8] = {'H', 'M', 'E', 'M', 'T', 'R', 'C', '\0'};
+static constexpr uint32_t VERSION = 1;
+
+enum class Compression : uint32_t {
+    NONE = 0,
+    ZLIB = 1 // Only available when built with zlib
+};
+
+enum class Type : uint8_t {
+    READ = 0,
+    WRITE = 1
+};
+
+struct Record {
+    uint64_t cycle;
+    uint64_t address;
+    uint64_t size;
+    Type type;
+};
+
+struct FileHeader {
+    char        magic[8];
+    uint32_t    version;
+    Compression compression;
+    uint32_t    records_per_block;
+    uint32_t    reserved;
+    uint64_t    num_records;    // Patched when the trace is closed, 0 if it never was
+};
+
+struct BlockHeader {
+    uint32_t num_records;
+    uint32_t raw_size;          // Size of the encoded records
+    uint32_t stored_size;       // Size on disk, equal to raw_size if the block is not compressed
+    uint32_t reserved;
+};
+
+static_assert(sizeof(FileHeader) == 32, "FileHeader layout must stay stable");
+static_assert(sizeof(BlockHeader) == 16, "BlockHeader layout must stay stable");
+
+/**
+ * @return True if this build can write and read the compression
+ */
+inline bool IsSupported(Compression compression) noexcept {
+#ifdef HAVE_ZLIB
+    return compression == Compression::NONE || compression == Compression::ZLIB;
+#else
+    return compression == Compression::NONE;
+#endif
+}
+
+} // namespace memory_trace
+
+#endif //SHARED_MEMORY_TRACE_MEMORY_TRACE_FORMAT_H
@@ -0,0 +1,70 @@
+#ifndef SHARED_MEMORY_TRACE_MEMORY_TRACE_READER_H
+#define SHARED_MEMORY_TRACE_MEMORY_TRACE_READER_H
+
+#include "memory_trace/memory_trace_format.h"
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace memory_trace {
+
+/**
+ * Streams the records of a memory trace back a block at a time, so memory use does not grow
+ * with the length of the trace.
+ */
+class MemoryTraceReader {
+public:
+
+    explicit MemoryTraceReader(const std::string& file);
+    ~MemoryTraceReader();
+
+    MemoryTraceReader(const MemoryTraceReader&) = delete;
+    MemoryTraceReader& operator=(const MemoryTraceReader&) = delete;
+
+    /**
+     * @return True if the file was opened, has a valid header and a compression this build supports
+     */
+    [[nodiscard]] bool IsValid() const noexcept { return m_valid; }
+
+    /**
+     * @return True if reading stopped at a truncated or corrupted block rather than the end of the trace
+     */
+    [[nodiscard]] bool IsCorrupted() const noexcept { return m_corrupted; }
+
+    [[nodiscard]] Compression GetCompression() const noexcept { return m_header.compression; }
+
+    /**
+     * @return Number of records the writer closed the trace with, 0 if it was never closed
+     */
+    [[nodiscard]] uint64_t GetNumRecords() const noexcept { return m_header.num_records; }
+
+    /**
+     * Decode the next record
+     * @return False at the end of the trace or if the trace is corrupted
+     */
+    bool Next(Record& record) noexcept;
+
+private:
+
+    bool ReadBlock() noexcept;
+
+    std::FILE* m_file = nullptr;
+    bool m_valid = false;
+    bool m_corrupted = false;
+    bool m_done = false;                /*!< End of the trace or corruption reached >*/
+
+    FileHeader m_header{};
+
+    std::vector<uint8_t> m_block;       /*!< Encoded records of the current block >*/
+    std::vector<uint8_t> m_stored;      /*!< Scratch space for a compressed block >*/
+    const uint8_t* m_position = nullptr;
+    const uint8_t* m_end = nullptr;
+    uint32_t m_block_records = 0;       /*!< Records left in the current block >*/
+    uint64_t m_previous_cycle = 0;
+    uint64_t m_previous_address = 0;
+};
+
+} // namespace memory_trace
+
+#endif //SHARED_MEMORY_TRACE_MEMORY_TRACE_READER_H
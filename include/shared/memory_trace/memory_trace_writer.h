@@ -0,0 +1,87 @@
+#ifndef SHARED_MEMORY_TRACE_MEMORY_TRACE_WRITER_H
+#define SHARED_MEMORY_TRACE_MEMORY_TRACE_WRITER_H
+
+#include "encoding/varint.h"
+#include "memory_trace/memory_trace_format.h"
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace memory_trace {
+
+/**
+ * Writes memory accesses into a delta and varint encoded trace. Records are encoded straight
+ * into the block buffer as they are appended, a full block is compressed and written out.
+ */
+class MemoryTraceWriter {
+public:
+
+    /**
+     * @param file Path of the trace to create
+     * @param compression Falls back to NONE if this build does not support it
+     * @param records_per_block Number of records encoded before a block gets written
+     */
+    explicit MemoryTraceWriter(const std::string& file, Compression compression = Compression::ZLIB,
+                               uint32_t records_per_block = 1u << 16u);
+    ~MemoryTraceWriter();
+
+    MemoryTraceWriter(const MemoryTraceWriter&) = delete;
+    MemoryTraceWriter& operator=(const MemoryTraceWriter&) = delete;
+
+    /**
+     * @return True if the file was created and nothing has failed writing to it
+     */
+    [[nodiscard]] bool IsOpen() const noexcept { return m_file != nullptr && !m_failed; }
+
+    /**
+     * Append an access to the trace, does nothing if the trace is not open
+     */
+    void Append(uint64_t cycle, Type type, uint64_t address, uint64_t size) noexcept {
+        // Nothing would flush the block of a trace that failed to open or was closed
+        if (!IsOpen()) {
+            return;
+        }
+        auto out = m_block.data() + m_block_size;
+        out += varint::Encode(varint::ZigZagEncode(static_cast<int64_t>(cycle - m_previous_cycle)), out);
+        out += varint::Encode((size << 1u) | static_cast<uint64_t>(type), out);
+        out += varint::Encode(varint::ZigZagEncode(static_cast<int64_t>(address - m_previous_address)), out);
+        m_block_size = out - m_block.data();
+        m_previous_cycle = cycle;
+        m_previous_address = address;
+        ++m_header.num_records;
+        if (++m_block_records == m_header.records_per_block) {
+            FlushBlock();
+        }
+    }
+
+    /**
+     * Flush the partial block and finalize the header. Called automatically on destruction.
+     * @return False if the trace could not be created or anything failed writing it
+     */
+    bool Close() noexcept;
+
+    [[nodiscard]] Compression GetCompression() const noexcept { return m_header.compression; }
+    [[nodiscard]] uint64_t GetNumRecords() const noexcept { return m_header.num_records; }
+
+private:
+
+    void FlushBlock() noexcept;
+    void Write(const void* data, size_t size) noexcept;
+
+    std::FILE* m_file = nullptr;
+    bool m_failed = false;
+
+    FileHeader m_header{};
+
+    std::vector<uint8_t> m_block;       /*!< Encoded records of the block being filled >*/
+    size_t m_block_size = 0;
+    uint32_t m_block_records = 0;
+    uint64_t m_previous_cycle = 0;
+    uint64_t m_previous_address = 0;
+    std::vector<uint8_t> m_compressed;  /*!< Scratch space for compressing a block >*/
+};
+
+} // namespace memory_trace
+
+#endif //SHARED_MEMORY_TRACE_MEMORY_TRACE_WRITER_H
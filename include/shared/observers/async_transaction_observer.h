@@ -0,0 +1,85 @@
+#ifndef SHARED_OBSERVERS_ASYNC_TRANSACTION_OBSERVER_H
+#define SHARED_OBSERVERS_ASYNC_TRANSACTION_OBSERVER_H
+
+#include "log/async_record_writer.h"
+#include "timing/cycle.h"
+
+#include <hestia/observer/i_connection_observer.h>
+
+#include <string>
+#include <type_traits>
+
+/**
+ * Connection observer that records every push and pop as a fixed size Record through an
+ * AsyncRecordWriter, so observing a busy connection costs a copy instead of formatted output on
+ * the simulation thread. Transactions that are not trivially copyable need a derived observer
+ * overriding ToRecord.
+ */
+template<typename T, typename Value = T>
+class AsyncTransactionObserver : public hestia::IConnectionObserver<T> {
+public:
+
+    static_assert(std::is_trivially_copyable<Value>::value, "Records are copied as raw bytes");
+
+    struct Record {
+        uint64_t cycle;
+        uint32_t size;
+        uint8_t popped;      /*!< 0 for a push, 1 for a pop >*/
+        uint8_t reserved[3];
+        Value value;
+    };
+
+    /**
+     * @param file Binary record file, an empty name disables the observer
+     * @param capacity Records buffered before the policy applies
+     * @param policy Drop or block when the background thread falls behind
+     */
+    AsyncTransactionObserver(const hestia::ObserverInit& init, const std::string& file, size_t capacity = 1u << 16u,
+                             AsyncRecordWriter::FullPolicy policy = AsyncRecordWriter::FullPolicy::BLOCK) :
+            hestia::IConnectionObserver<T>(init),
+            m_observer_init(init),
+            m_file(file),
+            m_writer(file, sizeof(Record), capacity, policy) {}
+
+    void Pushed(const T& transaction, uint32_t size) noexcept override {
+        Observe(transaction, size, 0);
+    }
+
+    void Popped(const T& transaction, uint32_t size) noexcept override {
+        Observe(transaction, size, 1);
+    }
+
+    /**
+     * Fails if the record file was asked for but could not be opened
+     */
+    bool Validate() const noexcept override { return m_file.empty() || m_writer.IsEnabled(); }
+
+    [[nodiscard]] uint64_t GetNumDropped() const noexcept { return m_writer.GetNumDropped(); }
+
+    /**
+     * @return True if the record file was asked for but could not be created or written
+     */
+    [[nodiscard]] bool HasFailed() const noexcept { return m_writer.HasFailed(); }
+
+protected:
+
+    virtual Value ToRecord(const T& transaction) const noexcept {
+        return static_cast<Value>(transaction);
+    }
+
+private:
+
+    void Observe(const T& transaction, uint32_t size, uint8_t popped) noexcept {
+        if (!m_writer.IsEnabled()) {
+            return;
+        }
+        Record record{CurrentCycle(m_observer_init), size, popped, {}, ToRecord(transaction)};
+        m_writer.Write(&record);
+    }
+
+    const hestia::ObserverInit m_observer_init;
+    const std::string m_file;
+    AsyncRecordWriter m_writer;
+};
+
+#endif //SHARED_OBSERVERS_ASYNC_TRANSACTION_OBSERVER_H
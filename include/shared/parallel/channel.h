@@ -0,0 +1,96 @@
+#ifndef SHARED_PARALLEL_CHANNEL_H
+#define SHARED_PARALLEL_CHANNEL_H
+
+#include "spsc_queue.h"
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+
+/**
+ * Type erased part of a channel, enough for the parallel runner to tell when a design is drained
+ */
+class ChannelBase {
+public:
+    explicit ChannelBase(uint64_t latency) : latency(latency) {}
+    virtual ~ChannelBase() = default;
+
+    [[nodiscard]] virtual bool Empty() const noexcept = 0;
+
+    const uint64_t latency; /*!< Cycles between a transaction being sent and it being delivered >*/
+};
+
+/**
+ * Timed connection between two partitions that may run on different threads. The sending side
+ * stamps every transaction with its cycle, the receiving side delivers it `latency` cycles later.
+ */
+template<typename T>
+class Channel : public ChannelBase {
+public:
+
+    struct Message {
+        uint64_t cycle = 0;     /*!< Cycle the transaction was sent in >*/
+        T transaction{};
+    };
+
+    explicit Channel(uint64_t latency) : ChannelBase(latency) {}
+
+    [[nodiscard]] bool Empty() const noexcept override { return queue.Empty(); }
+
+    SpscQueue<Message> queue;
+};
+
+/**
+ * Process wide lookup of channels by name. Both ends of a channel live in different test benches,
+ * so components find their channel through their "channel" parameter. Channels are created and
+ * cleared while no partition is running.
+ */
+class ChannelRegistry {
+public:
+
+    static ChannelRegistry& Instance();
+
+    /**
+     * Create a channel, replacing any channel with the same name
+     */
+    template<typename T>
+    Channel<T>& Create(const std::string& name, uint64_t latency) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto channel = new Channel<T>(latency);
+        m_channels[name].reset(channel);
+        return *channel;
+    }
+
+    /**
+     * @return The channel or nullptr if there is no channel of that name and type
+     */
+    template<typename T>
+    Channel<T>* Get(const std::string& name) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto found = m_channels.find(name);
+        return found == m_channels.end() ? nullptr : dynamic_cast<Channel<T>*>(found->second.get());
+    }
+
+    /**
+     * @return True when no channel holds an undelivered transaction
+     */
+    [[nodiscard]] bool Empty();
+
+    /**
+     * Smallest latency of all channels, the longest a partition may run ahead of the others. 1 when
+     * there are no channels
+     */
+    [[nodiscard]] uint64_t Lookahead();
+
+    void Clear();
+
+private:
+    ChannelRegistry() = default;
+
+    std::mutex m_mutex;
+    std::map<std::string, std::unique_ptr<ChannelBase>> m_channels;
+};
+
+#endif //SHARED_PARALLEL_CHANNEL_H
@@ -0,0 +1,79 @@
+#ifndef SHARED_PARALLEL_PARALLEL_SIMULATION_H
+#define SHARED_PARALLEL_PARALLEL_SIMULATION_H
+
+#include <hestia/testbench/cpp_test_bench.h>
+
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <vector>
+
+/**
+ * Runs several test benches (partitions) on worker threads. Partitions only talk to each other
+ * through Channels, so they can be clocked independently as long as none runs further ahead than
+ * the smallest channel latency. Time is split into epochs of that many cycles, every worker clocks
+ * its partitions through one epoch then waits for the others. A transaction sent in one epoch is
+ * never due before the next, and partitions are always clocked in the same order on the same
+ * worker, so results do not depend on the number of threads or on host timing.
+ *
+ * Every partition must be validated and set up before Run and torn down after it, with a single
+ * clock domain of period 1 so one Clock(1) is one cycle.
+ */
+class ParallelSimulation {
+public:
+
+    /**
+     * @param num_threads Worker threads, 0 to use one per host core
+     */
+    explicit ParallelSimulation(size_t num_threads = 0);
+
+    void AddPartition(hestia::CppTestBench& test_bench);
+
+    /**
+     * Clock every partition until all of them are idle and no channel holds a transaction
+     * @return Cycles until the last partition went idle, the same as clocking a single test bench
+     * while Clock(1) returns true, 0 without partitions
+     */
+    uint64_t Run();
+
+    [[nodiscard]] uint64_t GetNumEpochs() const noexcept { return m_num_epochs; }
+    [[nodiscard]] size_t GetNumThreads() const noexcept { return m_num_threads; }
+
+private:
+
+    /**
+     * Reusable barrier, the last thread to arrive runs the completion before releasing the others
+     */
+    class Barrier {
+    public:
+        Barrier(size_t num_threads, std::function<void()> completion) :
+                m_num_threads(num_threads), m_completion(std::move(completion)) {}
+        void Wait();
+    private:
+        std::mutex m_mutex;
+        std::condition_variable m_condition;
+        const size_t m_num_threads;
+        size_t m_arrived = 0;
+        uint64_t m_generation = 0;
+        std::function<void()> m_completion;
+    };
+
+    void Worker(size_t thread, Barrier& barrier);
+
+    /**
+     * Runs alone between epochs, decides if the design has drained
+     */
+    void EndEpoch();
+
+    std::vector<hestia::CppTestBench*> m_partitions;
+    std::vector<uint64_t> m_last_busy_cycle;    /*!< Per partition, cycle after its last busy Clock >*/
+    std::vector<char> m_busy;                   /*!< Per thread, any of its partitions busy this epoch >*/
+    size_t m_num_threads;
+    uint64_t m_epoch_cycles = 1;
+    uint64_t m_cycle = 0;                       /*!< First cycle of the current epoch >*/
+    uint64_t m_num_epochs = 0;
+    bool m_done = false;
+};
+
+#endif //SHARED_PARALLEL_PARALLEL_SIMULATION_H
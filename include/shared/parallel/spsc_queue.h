@@ -0,0 +1,101 @@
+#ifndef SHARED_PARALLEL_SPSC_QUEUE_H
+#define SHARED_PARALLEL_SPSC_QUEUE_H
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * Unbounded lock free queue for exactly one producer thread and one consumer thread. Items are
+ * stored in a linked list of fixed size blocks, the producer only ever touches the tail block and
+ * the consumer frees a block once it has read past it, so neither side waits on the other.
+ * T must be default constructible and movable.
+ */
+template<typename T, size_t BLOCK_SIZE = 256>
+class SpscQueue {
+public:
+
+    SpscQueue() : m_head(new Block()), m_tail(m_head) {}
+
+    ~SpscQueue() {
+        while (m_head != nullptr) {
+            auto next = m_head->next.load(std::memory_order_relaxed);
+            delete m_head;
+            m_head = next;
+        }
+    }
+
+    SpscQueue(const SpscQueue&) = delete;
+    SpscQueue& operator=(const SpscQueue&) = delete;
+
+    /**
+     * Producer side, never blocks
+     */
+    void Push(T item) {
+        if (m_tail_index == BLOCK_SIZE) {
+            auto block = new Block();
+            m_tail->next.store(block, std::memory_order_release);
+            m_tail = block;
+            m_tail_index = 0;
+        }
+        m_tail->items[m_tail_index] = std::move(item);
+        m_tail->committed.store(++m_tail_index, std::memory_order_release);
+        m_pushed.store(m_pushed.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+
+    /**
+     * Consumer side, oldest item or nullptr if the queue is empty. The pointer is valid until the
+     * next Pop.
+     */
+    T* Front() {
+        if (m_head_index == BLOCK_SIZE) {
+            auto next = m_head->next.load(std::memory_order_acquire);
+            if (next == nullptr) {
+                return nullptr;
+            }
+            delete m_head;
+            m_head = next;
+            m_head_index = 0;
+        }
+        if (m_head_index == m_head->committed.load(std::memory_order_acquire)) {
+            return nullptr;
+        }
+        return &m_head->items[m_head_index];
+    }
+
+    /**
+     * Consumer side, drop the item returned by Front
+     */
+    void Pop() {
+        ++m_head_index;
+        m_popped.store(m_popped.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+
+    /**
+     * Safe from any thread, but only exact while neither side is running
+     */
+    [[nodiscard]] bool Empty() const noexcept {
+        return m_pushed.load(std::memory_order_acquire) == m_popped.load(std::memory_order_acquire);
+    }
+
+private:
+
+    struct Block {
+        std::array<T, BLOCK_SIZE> items{};
+        std::atomic<size_t> committed{0};       /*!< Items written so far, published by the producer >*/
+        std::atomic<Block*> next{nullptr};
+    };
+
+    // Consumer
+    alignas(64) Block* m_head;
+    size_t m_head_index = 0;
+    std::atomic<uint64_t> m_popped{0};
+
+    // Producer
+    alignas(64) Block* m_tail;
+    size_t m_tail_index = 0;
+    std::atomic<uint64_t> m_pushed{0};
+};
+
+#endif //SHARED_PARALLEL_SPSC_QUEUE_H
@@ -0,0 +1,100 @@
+#ifndef SHARED_PYTHON_TEST_BENCH_VIEWS_H
+#define SHARED_PYTHON_TEST_BENCH_VIEWS_H
+
+#include <hestia/memory/i_memory.h>
+#include <hestia/testbench/cpp_test_bench.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/**
+ * Bulk access to a python test bench for ctypes. The hestia python module only returns one value
+ * per call, these functions fill contiguous buffers owned by the library in a single call so
+ * Python can wrap them as NumPy arrays without copying:
+ *
+ *     lib = ctypes.CDLL("libpython_processor.so")
+ *     lib.ReadCounterArray.restype = ctypes.POINTER(ctypes.c_uint64)
+ *     counters = numpy.ctypeslib.as_array(lib.ReadCounterArray(array), (num_names,))
+ *
+ * A returned buffer stays valid, and keeps its address, until the next call that refreshes it.
+ * Copy the array if it must outlive that.
+ */
+
+/**
+ * Test bench the functions below work on, set by CreateTestBench of the python library
+ */
+void SetViewTestBench(hestia::CppTestBench* test_bench) noexcept;
+
+/**
+ * Make a memory readable through ReadMemory, see MemoryView
+ */
+void RegisterViewMemory(const std::string& name, hestia::IMemory* memory);
+
+extern "C" {
+
+struct CounterArray;
+
+/**
+ * A fixed set of counters read together
+ * @param names Full counter names, as passed to GetCounterValue
+ */
+CounterArray* CreateCounterArray(const char* const* names, size_t num_names);
+
+void DestroyCounterArray(CounterArray* array);
+
+/**
+ * @return num_names counter values since the last ResetDesign, in the order the names were given
+ */
+const uint64_t* ReadCounterArray(CounterArray* array);
+
+/**
+ * Append a row of the current values to the history of the array
+ * @param cycle Stored as the first column of the row
+ */
+void SampleCounterArray(CounterArray* array, uint64_t cycle);
+
+/**
+ * @param num_rows Set to the number of rows sampled so far
+ * @return Row major num_rows x (1 + num_names) array, cycle first. Moves when a sample is added
+ * past the reserved rows.
+ */
+const uint64_t* GetCounterHistory(CounterArray* array, size_t* num_rows);
+
+/**
+ * Reserve room for rows so history views stay valid while sampling
+ */
+void ReserveCounterHistory(CounterArray* array, size_t num_rows);
+
+void ClearCounterHistory(CounterArray* array);
+
+/**
+ * Read a region of a memory registered by a MemoryView component
+ * @return size words, or nullptr if there is no such memory. Refreshed by the next ReadMemory on the
+ * same memory.
+ */
+const uint64_t* ReadMemory(const char* memory_name, uint64_t address, uint64_t size);
+
+/**
+ * @return False if there is no such memory
+ */
+bool WriteMemory(const char* memory_name, uint64_t address, const uint64_t* data, uint64_t size);
+
+/**
+ * Return an idle design to its post Setup state for another run, after changing parameters with
+ * SetParameters. Resets every component whose "reset_group" parameter was set to reset_group, and
+ * counter arrays restart from zero.
+ * @return Number of components reset
+ */
+size_t ResetDesign(const char* reset_group);
+
+/**
+ * Set many component parameters in one call
+ * @return Number of parameters set
+ */
+size_t SetParameters(const char* const* components, const char* const* names, const char* const* values,
+                     size_t num_parameters);
+
+}
+
+#endif //SHARED_PYTHON_TEST_BENCH_VIEWS_H
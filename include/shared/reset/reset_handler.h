@@ -0,0 +1,57 @@
+#ifndef SHARED_RESET_RESET_HANDLER_H
+#define SHARED_RESET_RESET_HANDLER_H
+
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+/**
+ * Member of a component that can be returned to its post Setup state without rebuilding the
+ * design. The handler joins the reset group named by the component's "reset_group" parameter and
+ * leaves it when the component is destroyed. An empty group name opts out.
+ */
+class ResetHandler {
+public:
+    ResetHandler(std::string group, std::function<void()> handler);
+    ~ResetHandler();
+
+    ResetHandler(const ResetHandler&) = delete;
+    ResetHandler& operator=(const ResetHandler&) = delete;
+
+    void operator()() const { m_handler(); }
+
+private:
+    const std::string m_group;
+    std::function<void()> m_handler;
+};
+
+/**
+ * Process wide reset groups, usually one per test bench
+ */
+class ResetRegistry {
+public:
+
+    static ResetRegistry& Instance();
+
+    /**
+     * Reset every member of a group, in the order they joined. Only valid while the design is idle,
+     * hestia connections, fifos and counters are not touched.
+     * @return Number of handlers called
+     */
+    size_t Reset(const std::string& group);
+
+private:
+    friend class ResetHandler;
+
+    ResetRegistry() = default;
+
+    void Add(const std::string& group, ResetHandler* handler);
+    void Remove(const std::string& group, ResetHandler* handler);
+
+    std::mutex m_mutex;
+    std::map<std::string, std::vector<ResetHandler*>> m_groups;
+};
+
+#endif //SHARED_RESET_RESET_HANDLER_H
@@ -0,0 +1,17 @@
+#ifndef SHARED_TIMING_CYCLE_H
+#define SHARED_TIMING_CYCLE_H
+
+#include <hestia/base/init.h>
+
+#include <cstdint>
+
+/**
+ * Current simulated cycle of the design the init belongs to. Used to timestamp transactions for
+ * profiling and tracing, and by the channel ends to decide when a transaction sent across
+ * partitions is due.
+ */
+inline uint64_t CurrentCycle(const hestia::Init& init) noexcept {
+    return init.scheduler->GetCurrentTime();
+}
+
+#endif //SHARED_TIMING_CYCLE_H
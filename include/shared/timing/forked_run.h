@@ -0,0 +1,52 @@
+#ifndef SHARED_TIMING_FORKED_RUN_H
+#define SHARED_TIMING_FORKED_RUN_H
+
+#include <type_traits>
+#include <utility>
+
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+/**
+ * Peak resident set size of the calling process in kilobytes
+ */
+inline long PeakRssKb() noexcept {
+    struct rusage usage{};
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_maxrss;
+}
+
+/**
+ * Call run in a forked child and pass its result back through a pipe, so peak RSS is per run and
+ * no state leaks between runs. The child exits straight after, without running destructors.
+ * @param run Called in the child, returns the result
+ * @param result Set to what the child returned
+ * @return False if the child could not be started, exited abnormally or its result did not arrive
+ */
+template <typename Result, typename Function>
+bool RunForked(Function&& run, Result& result) {
+    static_assert(std::is_trivially_copyable_v<Result>, "Results are copied through a pipe");
+    int fds[2];
+    if (pipe(fds) != 0) {
+        return false;
+    }
+    auto pid = fork();
+    if (pid == 0) {
+        close(fds[0]);
+        Result child_result = std::forward<Function>(run)();
+        auto written = write(fds[1], &child_result, sizeof(child_result));
+        _exit(written == sizeof(child_result) ? 0 : 1);
+    }
+    close(fds[1]);
+    bool received = pid > 0 && read(fds[0], &result, sizeof(result)) == sizeof(result);
+    close(fds[0]);
+    if (pid <= 0) {
+        return false;
+    }
+    int status = 0;
+    waitpid(pid, &status, 0);
+    return received && WIFEXITED(status) && WEXITSTATUS(status) == 0;
+}
+
+#endif //SHARED_TIMING_FORKED_RUN_H
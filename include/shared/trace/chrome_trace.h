@@ -0,0 +1,83 @@
+#ifndef SHARED_TRACE_CHROME_TRACE_H
+#define SHARED_TRACE_CHROME_TRACE_H
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+/**
+ * Buffers timeline events in memory and writes them out in the Chrome trace event JSON format
+ * (loadable by chrome://tracing and ui.perfetto.dev). Recording an event is a push of a small
+ * POD record, all formatting is deferred until Write. One simulated cycle is shown as one
+ * microsecond.
+ */
+class ChromeTrace {
+public:
+
+    using Track = uint32_t;
+    using Name = uint32_t;
+
+    explicit ChromeTrace(std::string process_name) : m_process_name(std::move(process_name)) {}
+
+    /**
+     * Create a new track (a row in the timeline)
+     */
+    Track AddTrack(const std::string& name);
+
+    /**
+     * Intern an event name so events only need to carry an index
+     */
+    Name AddName(const std::string& name);
+
+    /**
+     * Record an event that spans [start, end]
+     * @param id Value shown as the "id" argument of the event
+     */
+    void Complete(Track track, Name name, uint64_t start, uint64_t end, uint64_t id) {
+        m_events.push_back({start, end - start, id, track, name});
+    }
+
+    /**
+     * Open an interval on a track, does nothing if the track already has one open
+     */
+    void Begin(Track track, uint64_t cycle);
+
+    /**
+     * Close the open interval on a track, does nothing if the track has none open
+     */
+    void End(Track track, Name name, uint64_t cycle);
+
+    /**
+     * Reserve space for events up front to keep the recording path allocation free
+     */
+    void Reserve(size_t num_events) { m_events.reserve(num_events); }
+
+    /**
+     * Write all of the recorded events to a file
+     * @return False if the file could not be written
+     */
+    bool Write(const std::string& file) const;
+
+private:
+
+    struct Event {
+        uint64_t start;
+        uint64_t duration;
+        uint64_t id;
+        Track track;
+        Name name;
+    };
+
+    static constexpr uint64_t NOT_OPEN = ~static_cast<uint64_t>(0);
+
+    const std::string m_process_name;
+    std::vector<std::string> m_tracks;
+    std::vector<uint64_t> m_open; /*!< Start of the open interval per track >*/
+    std::vector<std::string> m_names;
+    std::unordered_map<std::string, Name> m_name_lookup;
+    std::vector<Event> m_events;
+};
+
+#endif //SHARED_TRACE_CHROME_TRACE_H
@@ -0,0 +1,51 @@
+#include "program/assembler.h"
+
+#include <cinttypes>
+#include <fstream>
+#include <sstream>
+#include <cstdio>
+#include <cstring>
+
+/**
+ * Assembles first_soc programs into program images, or prints an image back as assembly.
+ * Usage: assembler <source> <image>
+ *        assembler -d <image>
+ */
+int main(int argc, char* argv[]) {
+    if (argc == 3 && std::strcmp(argv[1], "-d") == 0) {
+        ProgramImage image{};
+        if (!image.Read(argv[2])) {
+            printf("Failed to read program image %s\n", argv[2]);
+            return 1;
+        }
+        printf(".origin %" PRIu64 "\n", image.load_address);
+        printf("%s", Assembler::Disassemble(image.words, image.load_address).c_str());
+        printf("; entry %" PRIu64 ", %zu relocations\n", image.load_address + image.entry, image.relocations.size());
+        return 0;
+    }
+    if (argc != 3) {
+        printf("Usage: %s <source> <image>\n       %s -d <image>\n", argv[0], argv[0]);
+        return 1;
+    }
+
+    std::ifstream input(argv[1]);
+    if (!input) {
+        printf("Failed to open %s\n", argv[1]);
+        return 1;
+    }
+    std::stringstream source;
+    source << input.rdbuf();
+
+    Assembler assembler{};
+    ProgramImage image{};
+    if (!assembler.Assemble(source.str(), image)) {
+        printf("%s:%s\n", argv[1], assembler.GetError().c_str());
+        return 1;
+    }
+    if (!image.Write(argv[2])) {
+        printf("Failed to write program image %s\n", argv[2]);
+        return 1;
+    }
+    printf("%s: %zu words, %zu relocations\n", argv[2], image.words.size(), image.relocations.size());
+    return 0;
+}
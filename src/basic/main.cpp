@@ -1,50 +1,232 @@
+#include "components/arbiter.h"
 #include "components/number_consumer.h"
 #include "components/number_producer.h"
+#include "timing/forked_run.h"
 
 #include <hestia/toolbox/testbenches/cpp_test_bench.h>
 
-int main(int argc, char* argv[]) {
+#include <chrono>
+#include <cinttypes>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+// Names of our components
+static const std::string consumer_name = "consumer";
+static const std::string producer_name = "producer";
+static const std::string arbiter_name = "arbiter";
+
+/**
+ * One point of the benchmark sweep
+ */
+struct Point {
+    uint64_t num_transactions = 100;
+    bool is_timed = true;
+    uint64_t clock_period = 10;
+    uint64_t num_producers = 1;         /*!< More than one producer or consumer goes through an arbiter >*/
+    uint64_t num_consumers = 1;
+    std::string policy = "round_robin"; /*!< Arbiter routing policy >*/
+};
+
+struct Measurement {
+    uint64_t clocks = 0;
+    double wall_seconds = 0;
+    long peak_rss_kb = 0;
+    bool valid = false;
+};
+
+/**
+ * The first producer and consumer keep their plain names
+ */
+static std::string Name(const std::string& name, uint64_t index) {
+    return index == 0 ? name : name + std::to_string(index);
+}
+
+/**
+ * Build, run and tear down the producers and consumers, only the clock loop is timed
+ */
+static Measurement Simulate(const Point& point) {
     // Instantiate our test bench
     hestia::CppTestBench test_bench{{
          {"consumer", hestia::CreateComponent<NumberConsumer>},
-         {"producer", hestia::CreateComponent<NumberProducer>}
+         {"producer", hestia::CreateComponent<NumberProducer>},
+         {"arbiter", hestia::CreateComponent<Arbiter<uint32_t>>}
      },
      {}
     };
 
     // Lets add a clock
-    test_bench.AddDomain("clk", 10);
+    test_bench.AddDomain("clk", point.clock_period);
 
-    // Names of our components
-    const std::string consumer_name = "consumer";
-    const std::string producer_name = "producer";
-
-    // Configure our producer
-    test_bench.SetParameter(hestia::FrameworkType::COMPONENT, producer_name, "num_transactions", "100");
-    test_bench.SetParameter(hestia::FrameworkType::COMPONENT, producer_name, "min_number", "0");
-    test_bench.SetParameter(hestia::FrameworkType::COMPONENT, producer_name, "max_number", "100");
+    // Configure our producers, the transactions are split between them and each gets its own seed
+    for (uint64_t i = 0; i < point.num_producers; i++) {
+        auto name = Name(producer_name, i);
+        auto num_transactions = point.num_transactions / point.num_producers +
+                                (i < point.num_transactions % point.num_producers ? 1 : 0);
+        test_bench.SetParameter(hestia::FrameworkType::COMPONENT, name, "num_transactions", std::to_string(num_transactions));
+        test_bench.SetParameter(hestia::FrameworkType::COMPONENT, name, "min_number", "0");
+        test_bench.SetParameter(hestia::FrameworkType::COMPONENT, name, "max_number", "100");
+        test_bench.SetParameter(hestia::FrameworkType::COMPONENT, name, "distribution", "uniform");
+        test_bench.SetParameter(hestia::FrameworkType::COMPONENT, name, "seed", std::to_string(i));
+    }
 
     // Create our components
-    test_bench.CreateComponent("consumer", consumer_name);
-    test_bench.CreateComponent("producer", producer_name);
+    for (uint64_t i = 0; i < point.num_consumers; i++) {
+        test_bench.CreateComponent("consumer", Name(consumer_name, i));
+    }
+    for (uint64_t i = 0; i < point.num_producers; i++) {
+        test_bench.CreateComponent("producer", Name(producer_name, i));
+    }
 
     // Connect our components
     hestia::ConnectionParameters connection_params{};
-    connection_params.is_timed = true;
-    connection_params.domain = "clk";
-    test_bench.CreateConnection(producer_name, "out", consumer_name, "in", connection_params);
+    connection_params.is_timed = point.is_timed;
+    if (point.is_timed) {
+        connection_params.domain = "clk";
+    }
+    if (point.num_producers == 1 && point.num_consumers == 1) {
+        test_bench.CreateConnection(producer_name, "out", consumer_name, "in", connection_params);
+    } else {
+        test_bench.SetParameter(hestia::FrameworkType::COMPONENT, arbiter_name, "num_outputs", std::to_string(point.num_consumers));
+        test_bench.SetParameter(hestia::FrameworkType::COMPONENT, arbiter_name, "policy", point.policy);
+        test_bench.CreateComponent("arbiter", arbiter_name);
+        for (uint64_t i = 0; i < point.num_producers; i++) {
+            test_bench.CreateConnection(Name(producer_name, i), "out", arbiter_name, "in", connection_params);
+        }
+        for (uint64_t i = 0; i < point.num_consumers; i++) {
+            test_bench.CreateConnection(arbiter_name, "out" + std::to_string(i), Name(consumer_name, i), "in", connection_params);
+        }
+    }
 
     // Validate the design
-    test_bench.Validate();
+    Measurement measurement{};
+    measurement.valid = test_bench.Validate();
 
     // Give everything a chance to setup
     test_bench.Setup();
 
     // Clock until no longer busy
-    while (test_bench.Clock(1)) {}
+    auto start = std::chrono::steady_clock::now();
+    while (test_bench.Clock(1)) {
+        ++measurement.clocks;
+    }
+    auto end = std::chrono::steady_clock::now();
 
     // Tear down the design
     test_bench.TearDown();
 
+    measurement.wall_seconds = std::chrono::duration<double>(end - start).count();
+    measurement.peak_rss_kb = PeakRssKb();
+    return measurement;
+}
+
+/**
+ * Run one point in a forked child so peak RSS is per point
+ */
+static Measurement Measure(const Point& point) {
+    Measurement measurement{};
+    if (!RunForked([&point]() { return Simulate(point); }, measurement)) {
+        measurement.valid = false;
+    }
+    return measurement;
+}
+
+/**
+ * Sweep transaction counts by decades up to max_transactions, timed and untimed connections and
+ * two clock periods. Connection FIFO depth is fixed by the framework so it is not swept.
+ */
+static std::vector<Point> BenchmarkPoints(uint64_t max_transactions) {
+    std::vector<Point> points;
+    for (uint64_t num_transactions = 100; num_transactions <= max_transactions; num_transactions *= 10) {
+        for (bool is_timed : {true, false}) {
+            for (uint64_t clock_period : {1, 10}) {
+                points.push_back({num_transactions, is_timed, clock_period});
+            }
+        }
+    }
+    return points;
+}
+
+/**
+ * Sweep fan in and fan out through the arbiter with every routing policy at a fixed transaction count
+ */
+static std::vector<Point> TopologyPoints(uint64_t num_transactions) {
+    std::vector<Point> points;
+    for (uint64_t num_producers : {1, 4, 16}) {
+        for (uint64_t num_consumers : {1, 4, 16}) {
+            for (auto const& policy : {"round_robin", "least_loaded", "hash"}) {
+                points.push_back({num_transactions, true, 10, num_producers, num_consumers, policy});
+                // A single pair is connected directly, there is nothing to route
+                if (num_producers == 1 && num_consumers == 1) {
+                    break;
+                }
+            }
+        }
+    }
+    return points;
+}
+
+static int Run(const std::vector<Point>& points, const std::string& output_file) {
+    auto output = std::fopen(output_file.c_str(), "w");
+    if (output == nullptr) {
+        printf("Failed to create %s\n", output_file.c_str());
+        return 1;
+    }
+    std::fprintf(output, "{\n  \"benchmark\": \"basic\",\n  \"results\": [\n");
+    printf("%12s %6s %6s %5s %5s %-12s %14s %12s %10s\n", "transactions", "timed", "period", "prod", "cons",
+           "policy", "trans/s", "clocks/trans", "rss kb");
+    size_t written = 0;
+    for (auto const& point : points) {
+        auto measurement = Measure(point);
+        if (!measurement.valid) {
+            printf("%12" PRIu64 " %6d %6" PRIu64 " %5" PRIu64 " %5" PRIu64 " %-12s failed\n", point.num_transactions, point.is_timed, point.clock_period,
+                   point.num_producers, point.num_consumers, point.policy.c_str());
+            continue;
+        }
+        auto transactions_per_second = point.num_transactions / measurement.wall_seconds;
+        auto clocks_per_transaction = static_cast<double>(measurement.clocks) / point.num_transactions;
+        std::fprintf(output, "%s", written == 0 ? "" : ",\n");
+        std::fprintf(output, "    {\"transactions\": %" PRIu64 ", \"timed\": %s, \"clock_period\": %" PRIu64 ", \"producers\": %" PRIu64 ", "
+                             "\"consumers\": %" PRIu64 ", \"policy\": \"%s\", \"clocks\": %" PRIu64 ", \"wall_seconds\": %.6f, "
+                             "\"peak_rss_kb\": %ld, \"transactions_per_second\": %.0f, \"clocks_per_transaction\": %.4f}",
+                     point.num_transactions, point.is_timed ? "true" : "false", point.clock_period, point.num_producers,
+                     point.num_consumers, point.policy.c_str(), measurement.clocks, measurement.wall_seconds, measurement.peak_rss_kb, transactions_per_second, clocks_per_transaction);
+        ++written;
+        printf("%12" PRIu64 " %6d %6" PRIu64 " %5" PRIu64 " %5" PRIu64 " %-12s %14.0f %12.4f %10ld\n", point.num_transactions, point.is_timed,
+               point.clock_period, point.num_producers, point.num_consumers, point.policy.c_str(),
+               transactions_per_second, clocks_per_transaction, measurement.peak_rss_kb);
+    }
+    std::fprintf(output, "\n  ]\n}\n");
+    std::fclose(output);
+    return 0;
+}
+
+/**
+ * Usage: basic [benchmark|topology [-n transactions] [-o output file]]
+ * Without arguments runs 100 transactions once. benchmark sweeps the connection overhead up to
+ * -n transactions, topology sweeps producer and consumer counts through the arbiter at -n.
+ */
+int main(int argc, char* argv[]) {
+    bool is_benchmark = argc > 1 && std::strcmp(argv[1], "benchmark") == 0;
+    bool is_topology = argc > 1 && std::strcmp(argv[1], "topology") == 0;
+    if (is_benchmark || is_topology) {
+        uint64_t num_transactions = is_benchmark ? 100000000 : 1000000;
+        std::string output_file = is_benchmark ? "basic_benchmark.json" : "basic_topology.json";
+        for (int i = 2; i + 1 < argc; i += 2) {
+            if (std::strcmp(argv[i], "-n") == 0) {
+                num_transactions = std::strtoull(argv[i + 1], nullptr, 10);
+            } else if (std::strcmp(argv[i], "-o") == 0) {
+                output_file = argv[i + 1];
+            } else {
+                printf("Usage: %s [benchmark|topology [-n transactions] [-o output file]]\n", argv[0]);
+                return 1;
+            }
+        }
+        return Run(is_benchmark ? BenchmarkPoints(num_transactions) : TopologyPoints(num_transactions), output_file);
+    }
+
+    Simulate(Point{});
     return 0;
-}
\ No newline at end of file
+}
@@ -1,5 +1,7 @@
+#include <components/arbiter.h>
 #include <components/number_consumer.h>
 #include <components/number_producer.h>
+#include <python/test_bench_views.h>
 
 #include <hestia/toolbox/testbenches/cpp_test_bench.h>
 #include <hestia/toolbox/testbenches/python/test_bench.h>
@@ -9,11 +11,14 @@ public:
     SandboxTestBench() : hestia::CppTestBench() {
         AddComponentFactories({
             {"number_consumer", hestia::CreateComponent<NumberConsumer>},
-            {"number_producer", hestia::CreateComponent<NumberProducer>}
+            {"number_producer", hestia::CreateComponent<NumberProducer>},
+            {"arbiter", hestia::CreateComponent<Arbiter<uint32_t>>}
         });
     }
 };
 
 hestia::ITestBench* CreateTestBench() noexcept {
-    return new SandboxTestBench();
+    auto test_bench = new SandboxTestBench();
+    SetViewTestBench(test_bench);
+    return test_bench;
 }
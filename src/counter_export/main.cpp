@@ -0,0 +1,57 @@
+#include "counter_store/columnar_reader.h"
+
+#include <cinttypes>
+#include <cstdio>
+#include <vector>
+
+/**
+ * Converts a columnar counter store back into the csv layout of the csv sampler.
+ * Usage: counter_export <store> [output.csv]
+ */
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        printf("Usage: %s <store> [output.csv]\n", argv[0]);
+        return 1;
+    }
+
+    counter_store::ColumnarReader reader(argv[1]);
+    if (!reader.IsValid()) {
+        printf("Failed to read counter store: %s\n", argv[1]);
+        return 1;
+    }
+
+    auto output = argc > 2 ? std::fopen(argv[2], "w") : stdout;
+    if (output == nullptr) {
+        printf("Failed to open output file: %s\n", argv[2]);
+        return 1;
+    }
+
+    // Header
+    auto const& columns = reader.GetColumns();
+    for (size_t column = 0; column < columns.size(); column++) {
+        std::fprintf(output, column == 0 ? "%s" : ",%s", columns[column].c_str());
+    }
+    std::fputc('\n', output);
+
+    // Decode a block of every column and then write it out row by row
+    std::vector<std::vector<uint64_t>> block(columns.size());
+    for (size_t index = 0; index < reader.GetNumBlocks(); index++) {
+        for (size_t column = 0; column < columns.size(); column++) {
+            if (!reader.ReadBlock(index, column, block[column])) {
+                printf("Corrupted block %zu in counter store: %s\n", index, argv[1]);
+                return 1;
+            }
+        }
+        for (uint32_t row = 0; row < reader.GetNumBlockRows(index); row++) {
+            for (size_t column = 0; column < columns.size(); column++) {
+                std::fprintf(output, column == 0 ? "%" PRIu64 : ",%" PRIu64, block[column][row]);
+            }
+            std::fputc('\n', output);
+        }
+    }
+
+    if (output != stdout) {
+        std::fclose(output);
+    }
+    return 0;
+}
@@ -0,0 +1,59 @@
+#include "log/event_log.h"
+
+#include <cinttypes>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+/**
+ * Prints a binary event log as text, one event per line.
+ * Usage: event_dump <event log>
+ */
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        printf("Usage: %s <event log>\n", argv[0]);
+        return 1;
+    }
+
+    auto input = std::fopen(argv[1], "rb");
+    if (input == nullptr) {
+        printf("Failed to open event log: %s\n", argv[1]);
+        return 1;
+    }
+
+    char magic[8];
+    uint32_t version = 0;
+    uint32_t num_names = 0;
+    if (std::fread(magic, sizeof(magic), 1, input) != 1 || std::memcmp(magic, "HEVTLOG", 8) != 0 ||
+        std::fread(&version, sizeof(version), 1, input) != 1 || version != EventLog::VERSION ||
+        std::fread(&num_names, sizeof(num_names), 1, input) != 1) {
+        printf("Not an event log: %s\n", argv[1]);
+        return 1;
+    }
+
+    std::vector<std::string> names(num_names);
+    for (auto& name : names) {
+        uint16_t length = 0;
+        if (std::fread(&length, sizeof(length), 1, input) != 1) {
+            printf("Truncated event log: %s\n", argv[1]);
+            return 1;
+        }
+        name.resize(length);
+        if (length != 0 && std::fread(&name[0], 1, length, input) != length) {
+            printf("Truncated event log: %s\n", argv[1]);
+            return 1;
+        }
+    }
+
+    static const char* levels[] = {"DEBUG", "INFO", "WARNING"};
+    EventLog::Entry entry{};
+    while (std::fread(&entry, sizeof(entry), 1, input) == 1) {
+        auto name = entry.event < names.size() ? names[entry.event].c_str() : "unknown";
+        auto level = entry.level < 3 ? levels[entry.level] : "?";
+        printf("%" PRIu64 " %s %s %" PRIu64 " %" PRIu64 " %" PRIu64 " %" PRIu64 "\n", entry.cycle, level, name,
+               entry.args[0], entry.args[1], entry.args[2], entry.args[3]);
+    }
+    std::fclose(input);
+    return 0;
+}
@@ -0,0 +1,27 @@
+#include "applications/image_application.h"
+
+#include <hestia/memory/memory_manager.h>
+
+ImageApplication::ImageApplication(const hestia::ComponentInit &init) :
+        Manageable(hestia::FrameworkType::COMPONENT, init.name),
+        hestia::ComponentBase(init),
+        // Port
+        m_doorbell(CreatePortInit("doorbell")),
+        // Memory
+        m_memory(m_init.memories->GetMemory(GetParam("memory_name"))),
+        m_image_file(GetParam("image_file")),
+        // Map the image rather than reading it, the words go straight from the mapping into memory
+        m_image(m_image_file) {}
+
+void ImageApplication::Setup() noexcept {
+    // Allocate the image and move its addresses to where it landed
+    auto address = m_memory->Allocate(m_image.GetNumWords());
+    if (!m_image.Relocate(address)) {
+        auto message = "Program image " + m_image_file + " can not be loaded at " + std::to_string(address);
+        m_logger.LogLn(hestia::LoggingType::WARNING, message.c_str());
+        return;
+    }
+    m_memory->Set(address, m_image.GetWords(), m_image.GetNumWords());
+    // Write the entry point out through our doorbell port
+    m_doorbell.Write(address + m_image.GetEntry());
+}
@@ -0,0 +1,270 @@
+#include "applications/kernel_application.h"
+
+#include <program/assembler.h>
+
+#include <hestia/memory/memory_manager.h>
+
+#include <numeric>
+
+KernelApplication::KernelApplication(const hestia::ComponentInit &init) :
+        Manageable(hestia::FrameworkType::COMPONENT, init.name),
+        hestia::ComponentBase(init),
+        // Port
+        m_doorbell(CreatePortInit("doorbell")),
+        // Memory
+        m_memory(m_init.memories->GetMemory(GetParam("memory_name"))),
+        m_kernel(GetParam("kernel")),
+        m_size(GetUintParam("size")),
+        // Counters
+        m_passed("passed", this, m_init),
+        m_failed("failed", this, m_init) {}
+
+bool KernelApplication::Validate() const noexcept {
+    auto known = m_kernel == "memcpy" || m_kernel == "dot" || m_kernel == "pointer_chase" ||
+                 m_kernel == "histogram" || m_kernel == "matmul" || m_kernel == "reduction";
+    return known && m_size != 0;
+}
+
+void KernelApplication::Setup() noexcept {
+    std::string source;
+    if (m_kernel == "memcpy") {
+        source = Memcpy();
+    } else if (m_kernel == "dot") {
+        source = Dot();
+    } else if (m_kernel == "pointer_chase") {
+        source = PointerChase();
+    } else if (m_kernel == "histogram") {
+        source = Histogram();
+    } else if (m_kernel == "matmul") {
+        source = Matmul();
+    } else {
+        source = Reduction();
+    }
+
+    Assembler assembler{};
+    ProgramImage image{};
+    if (!assembler.Assemble(source, image)) {
+        m_logger.LogLn(hestia::LoggingType::WARNING, ("Failed to assemble " + m_kernel + ": " + assembler.GetError()).c_str());
+        return;
+    }
+    // Allocate the image and move its addresses to where it landed
+    auto address = m_memory->Allocate(image.words.size());
+    if (!image.Relocate(address)) {
+        auto message = "Kernel " + m_kernel + " can not be loaded at " + std::to_string(address);
+        m_logger.LogLn(hestia::LoggingType::WARNING, message.c_str());
+        return;
+    }
+    m_memory->Set(address, image.words.data(), image.words.size());
+    // Write the entry point out through our doorbell port
+    m_doorbell.Write(address + image.entry);
+}
+
+void KernelApplication::TearDown() noexcept {
+    if (m_expected.empty()) {
+        return;
+    }
+    auto result = m_memory->Get(m_result_address, m_expected.size());
+    auto matches = std::equal(m_expected.begin(), m_expected.end(), result.begin(), result.end());
+    if (matches) {
+        ++m_passed;
+    } else {
+        ++m_failed;
+    }
+    m_logger.LogLn(matches ? hestia::LoggingType::INFO : hestia::LoggingType::WARNING,
+                   (m_kernel + (matches ? " produced the expected result" : " produced the wrong result")).c_str());
+}
+
+hestia::IMemory::Address KernelApplication::AllocateData(const std::vector<uint64_t> &data) {
+    auto address = m_memory->Allocate(data.size());
+    m_memory->Set(address, data.data(), data.size());
+    return address;
+}
+
+std::vector<uint64_t> KernelApplication::RandomData(uint64_t size, uint64_t max) {
+    std::uniform_int_distribution<uint64_t> distribution(0, max - 1);
+    std::vector<uint64_t> data(size);
+    for (auto& value : data) {
+        value = distribution(m_random);
+    }
+    return data;
+}
+
+// dst[i] = src[i]
+std::string KernelApplication::Memcpy() {
+    auto source = RandomData(m_size, 1u << 16u);
+    auto source_address = AllocateData(source);
+    m_result_address = AllocateData(std::vector<uint64_t>(m_size, 0));
+    m_expected = source;
+    auto n = std::to_string(m_size);
+    return "    MOVE #" + std::to_string(source_address) + " -> r1\n"
+           "    MOVE #" + std::to_string(m_result_address) + " -> r2\n"
+           "    MOVE 0 -> r3\n"
+           "loop:\n"
+           "    MOVE [r1] -> [r2]\n"
+           "    INCREMENT r1 -> r1\n"
+           "    INCREMENT r2 -> r2\n"
+           "    INCREMENT r3 -> r3\n"
+           "    COMPARE r3, " + n + "\n"
+           "    JUMP_LESS loop\n"
+           "    ENDPRGM\n";
+}
+
+// sum += a[i] * b[i]
+std::string KernelApplication::Dot() {
+    auto a = RandomData(m_size, 256);
+    auto b = RandomData(m_size, 256);
+    auto a_address = AllocateData(a);
+    auto b_address = AllocateData(b);
+    m_result_address = AllocateData({0});
+    m_expected = {std::inner_product(a.begin(), a.end(), b.begin(), static_cast<uint64_t>(0))};
+    auto n = std::to_string(m_size);
+    return "    MOVE #" + std::to_string(a_address) + " -> r1\n"
+           "    MOVE #" + std::to_string(b_address) + " -> r2\n"
+           "    MOVE 0 -> r3\n"
+           "    MOVE 0 -> r4\n"
+           "loop:\n"
+           "    MOVE [r1] -> r5\n"
+           "    MOVE [r2] -> r6\n"
+           "    MULTIPLY r5, r6 -> r7\n"
+           "    ADD r4, r7 -> r4\n"
+           "    INCREMENT r1 -> r1\n"
+           "    INCREMENT r2 -> r2\n"
+           "    INCREMENT r3 -> r3\n"
+           "    COMPARE r3, " + n + "\n"
+           "    JUMP_LESS loop\n"
+           "    MOVE #" + std::to_string(m_result_address) + " -> r8\n"
+           "    MOVE r4 -> [r8]\n"
+           "    ENDPRGM\n";
+}
+
+// p = *p, every step depends on the load before it
+std::string KernelApplication::PointerChase() {
+    // Sattolo's shuffle gives a single cycle through every element
+    std::vector<uint64_t> order(m_size);
+    std::iota(order.begin(), order.end(), 0);
+    for (uint64_t i = m_size - 1; i > 0; i--) {
+        std::uniform_int_distribution<uint64_t> distribution(0, i - 1);
+        std::swap(order[i], order[distribution(m_random)]);
+    }
+    auto base = m_memory->Allocate(m_size);
+    std::vector<uint64_t> next(m_size);
+    for (uint64_t i = 0; i < m_size; i++) {
+        next[i] = base + order[i];
+    }
+    m_memory->Set(base, next.data(), next.size());
+    m_result_address = AllocateData({0});
+    // Follow the cycle on the host for the reference
+    uint64_t pointer = base;
+    for (uint64_t i = 0; i < m_size; i++) {
+        pointer = next[pointer - base];
+    }
+    m_expected = {pointer};
+    auto n = std::to_string(m_size);
+    return "    MOVE #" + std::to_string(base) + " -> r1\n"
+           "    MOVE 0 -> r3\n"
+           "loop:\n"
+           "    MOVE [r1] -> r1\n"
+           "    INCREMENT r3 -> r3\n"
+           "    COMPARE r3, " + n + "\n"
+           "    JUMP_LESS loop\n"
+           "    MOVE #" + std::to_string(m_result_address) + " -> r8\n"
+           "    MOVE r1 -> [r8]\n"
+           "    ENDPRGM\n";
+}
+
+// bins[data[i]] += 1, a read modify write through memory every iteration
+std::string KernelApplication::Histogram() {
+    auto data = RandomData(m_size, HISTOGRAM_BINS);
+    auto data_address = AllocateData(data);
+    m_result_address = AllocateData(std::vector<uint64_t>(HISTOGRAM_BINS, 0));
+    m_expected.assign(HISTOGRAM_BINS, 0);
+    for (auto const& value : data) {
+        ++m_expected[value];
+    }
+    auto n = std::to_string(m_size);
+    return "    MOVE #" + std::to_string(data_address) + " -> r1\n"
+           "    MOVE #" + std::to_string(m_result_address) + " -> r2\n"
+           "    MOVE 0 -> r3\n"
+           "loop:\n"
+           "    MOVE [r1] -> r4\n"
+           "    ADD r2, r4 -> r5\n"
+           "    MOVE [r5] -> r6\n"
+           "    INCREMENT r6 -> r6\n"
+           "    MOVE r6 -> [r5]\n"
+           "    INCREMENT r1 -> r1\n"
+           "    INCREMENT r3 -> r3\n"
+           "    COMPARE r3, " + n + "\n"
+           "    JUMP_LESS loop\n"
+           "    ENDPRGM\n";
+}
+
+// C[i][j] = sum over k of A[i][k] * B[k][j], row major
+std::string KernelApplication::Matmul() {
+    auto a = RandomData(m_size * m_size, 16);
+    auto b = RandomData(m_size * m_size, 16);
+    auto a_address = AllocateData(a);
+    auto b_address = AllocateData(b);
+    m_result_address = AllocateData(std::vector<uint64_t>(m_size * m_size, 0));
+    m_expected.assign(m_size * m_size, 0);
+    for (uint64_t i = 0; i < m_size; i++) {
+        for (uint64_t j = 0; j < m_size; j++) {
+            for (uint64_t k = 0; k < m_size; k++) {
+                m_expected[i * m_size + j] += a[i * m_size + k] * b[k * m_size + j];
+            }
+        }
+    }
+    auto n = std::to_string(m_size);
+    return "    MOVE 0 -> r1\n"
+           "i_loop:\n"
+           "    MOVE 0 -> r2\n"
+           "j_loop:\n"
+           "    MOVE 0 -> r3\n"
+           "    MOVE 0 -> r4\n"
+           "    MULTIPLY r1, " + n + " -> r5\n"
+           "    ADD r5, #" + std::to_string(a_address) + " -> r6\n"
+           "    ADD r2, #" + std::to_string(b_address) + " -> r7\n"
+           "k_loop:\n"
+           "    MOVE [r6] -> r8\n"
+           "    MOVE [r7] -> r9\n"
+           "    MULTIPLY r8, r9 -> r8\n"
+           "    ADD r4, r8 -> r4\n"
+           "    INCREMENT r6 -> r6\n"
+           "    ADD r7, " + n + " -> r7\n"
+           "    INCREMENT r3 -> r3\n"
+           "    COMPARE r3, " + n + "\n"
+           "    JUMP_LESS k_loop\n"
+           "    ADD r5, r2 -> r8\n"
+           "    ADD r8, #" + std::to_string(m_result_address) + " -> r8\n"
+           "    MOVE r4 -> [r8]\n"
+           "    INCREMENT r2 -> r2\n"
+           "    COMPARE r2, " + n + "\n"
+           "    JUMP_LESS j_loop\n"
+           "    INCREMENT r1 -> r1\n"
+           "    COMPARE r1, " + n + "\n"
+           "    JUMP_LESS i_loop\n"
+           "    ENDPRGM\n";
+}
+
+// sum of data, counting down inside a called subroutine
+std::string KernelApplication::Reduction() {
+    auto data = RandomData(m_size, 1u << 16u);
+    auto data_address = AllocateData(data);
+    m_result_address = AllocateData({0});
+    m_expected = {std::accumulate(data.begin(), data.end(), static_cast<uint64_t>(0))};
+    return "    CALL sum\n"
+           "    MOVE #" + std::to_string(m_result_address) + " -> r8\n"
+           "    MOVE r4 -> [r8]\n"
+           "    ENDPRGM\n"
+           "sum:\n"
+           "    MOVE #" + std::to_string(data_address) + " -> r1\n"
+           "    MOVE " + std::to_string(m_size) + " -> r3\n"
+           "    MOVE 0 -> r4\n"
+           "loop:\n"
+           "    MOVE [r1] -> r5\n"
+           "    ADD r4, r5 -> r4\n"
+           "    INCREMENT r1 -> r1\n"
+           "    DECREMENT r3 -> r3\n"
+           "    COMPARE 0, r3\n"
+           "    JUMP_LESS loop\n"
+           "    RETURN\n";
+}
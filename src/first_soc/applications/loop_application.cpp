@@ -3,6 +3,10 @@
 
 #include <hestia/memory/memory_manager.h>
 #include <functional/functional_processor_library.h>
+#include <program/program_writer.h>
+
+#include <algorithm>
+#include <cassert>
 #include <random>
 
 uint64_t LoopApplication::m_write_back_register = 0;
@@ -17,65 +21,74 @@ LoopApplication::LoopApplication(const hestia::ComponentInit &init) :
         m_memory(m_init.memories->GetMemory(GetParam("memory_name"))),
         m_num_iterations(GetUintParam("num_iterations")),
         m_num_ops_per_iteration(GetUintParam("num_ops_per_iteration")),
-        m_instruction_type_mode(GetParam("mode")) {}
+        m_instruction_type_mode(GetParam("mode")),
+        // Reset
+        m_reset_handler(GetParam("reset_group"), std::bind(&LoopApplication::Reset, this)) {}
 
 void LoopApplication::Setup() noexcept {
     // Create Surface
     m_write_back_address = m_memory->Allocate(1);
-    std::vector<hestia::IMemory::Data> surface;
-    // Loop over creating the correct number of operations
-    for (uint64_t i = 0; i < m_num_ops_per_iteration; i++) {
-        AddInstruction(CreateInstruction(), surface);
-    }
-    // Add the loop logic
-    AddInstruction(LoopLogicInstructions(), surface);
-    // End program
-    AddInstruction(CreateENDPRGMInstruction(), surface);
-    // Allocate the surface and set it
-    m_application_start_address = m_memory->Allocate(surface.size());
-    m_memory->Set(m_application_start_address, surface.data(), surface.size());
-    // Write the address out through our doorbell port
-    m_doorbell.Write(m_application_start_address);
+    WriteProgram();
 }
 
-void LoopApplication::AddInstruction(
-        const Instruction& instruction,
-        std::vector<hestia::IMemory::Data> &surface) {
-
-    auto encoded_values = FunctionalProcessorLibrary::Encode(instruction);
-    for (auto const& value : encoded_values) {
-        surface.emplace_back(value);
-    }
+void LoopApplication::Reset() {
+    m_num_iterations = GetUintParam("num_iterations");
+    m_num_ops_per_iteration = GetUintParam("num_ops_per_iteration");
+    m_instruction_type_mode = GetParam("mode");
+    m_generate_alu = false;
+    m_random.seed();
+    const hestia::IMemory::Data zero = 0;
+    m_memory->Set(m_write_back_address, &zero, 1);
+    WriteProgram();
 }
 
-void LoopApplication::AddInstruction(const std::vector<Instruction> &instructions, std::vector<hestia::IMemory::Data> &surface) {
-    for(auto const& instruction : instructions) {
-        AddInstruction(instruction, surface);
+void LoopApplication::WriteProgram() {
+    // Every loop body instruction is one of two fixed instructions, encode them once up front
+    std::vector<uint64_t> add(FunctionalProcessorLibrary::Encode(CreateAddInstruction()));
+    std::vector<uint64_t> move(FunctionalProcessorLibrary::Encode(CreateMoveInstruction()));
+    auto end_program = CreateENDPRGMInstruction();
+    // Size the program so it is allocated once, the body is sized for the larger instruction
+    uint64_t size = m_num_ops_per_iteration * std::max(add.size(), move.size()) +
+                    FunctionalProcessorLibrary::EncodedSize(end_program);
+    // The jump target is a constant operand, so the size of the loop logic does not depend on where it goes
+    for (auto const& instruction : LoopLogicInstructions()) {
+        size += FunctionalProcessorLibrary::EncodedSize(instruction);
+    }
+    if (size > m_program_capacity) {
+        m_application_start_address = m_memory->Allocate(size);
+        m_program_capacity = size;
     }
+    auto loop_logic = LoopLogicInstructions();
+    // Stream the program straight into memory
+    {
+        ProgramWriter writer(m_memory, m_application_start_address);
+        // Loop over creating the correct number of operations
+        for (uint64_t i = 0; i < m_num_ops_per_iteration; i++) {
+            auto const& words = GenerateAlu() ? add : move;
+            writer.Add(words.data(), words.size());
+        }
+        // Add the loop logic
+        writer.Add(loop_logic);
+        // End program
+        writer.Add(end_program);
+    }
+    // Write the address out through our doorbell port
+    m_doorbell.Write(m_application_start_address);
 }
 
-// 2 + 3 set result at memory location = 2
-Instruction LoopApplication::CreateInstruction() {
+bool LoopApplication::GenerateAlu() {
     if(m_instruction_type_mode == "alu") {
-        return CreateAddInstruction();
+        return true;
     } else if (m_instruction_type_mode == "memory") {
-        return CreateMoveInstruction();
+        return false;
     } else if (m_instruction_type_mode == "split") {
         m_generate_alu = !m_generate_alu;
-        if(m_generate_alu) {
-            return CreateAddInstruction();
-        } else {
-            return CreateMoveInstruction();
-        }
+        return m_generate_alu;
     } else if (m_instruction_type_mode == "random") {
-        static auto gen = std::bind(std::uniform_int_distribution<>(0,1), std::default_random_engine());
-        if(gen()) {
-            return CreateAddInstruction();
-        } else {
-            return CreateMoveInstruction();
-        }
+        return std::uniform_int_distribution<>(0, 1)(m_random) != 0;
     }
     assert(false);
+    return false;
 }
 
 // 2 + 3 set result at memory location = 2
@@ -129,8 +142,9 @@ std::vector<Instruction> LoopApplication::LoopLogicInstructions() {
     auto& jump = instructions[2];
     jump.opcode = Opcode::JUMP_LESS;
     jump.operands.resize(1);
-    jump.operands[0].type = Operand::Type::EMBEDDED;
-    jump.operands[0].value = 1;
+    // Back to the start of this application's own program, other applications share the memory
+    jump.operands[0].type = Operand::Type::CONSTANT;
+    jump.operands[0].value = static_cast<int64_t>(m_application_start_address);
     return instructions;
 }
 
@@ -3,6 +3,7 @@
 
 #include <hestia/memory/memory_manager.h>
 #include <functional/functional_processor_library.h>
+#include <program/program_writer.h>
 
 SimpleApplication::SimpleApplication(const hestia::ComponentInit &init) :
         Manageable(hestia::FrameworkType::COMPONENT, init.name),
@@ -13,28 +14,22 @@ SimpleApplication::SimpleApplication(const hestia::ComponentInit &init) :
         m_memory(m_init.memories->GetMemory(GetParam("memory_name"))) {}
 
 void SimpleApplication::Setup() noexcept {
-    // Create Surface
-    std::vector<hestia::IMemory::Data> surface;
-    AddInstruction(CreateAddInstruction(), surface);
-    AddInstruction(CreateENDPRGMInstruction(), surface);
-    surface.emplace_back(0); // Place for our result
-    // Allocate the surface and set it
-    auto address = m_memory->Allocate(surface.size());
-    m_memory->Set(address, surface.data(), surface.size());
+    auto add = CreateAddInstruction();
+    auto end_program = CreateENDPRGMInstruction();
+    // Allocate the surface, plus a place for our result
+    auto address = m_memory->Allocate(FunctionalProcessorLibrary::EncodedSize(add) +
+                                      FunctionalProcessorLibrary::EncodedSize(end_program) + 1);
+    {
+        ProgramWriter writer(m_memory, address);
+        writer.Add(add);
+        writer.Add(end_program);
+        const uint64_t result = 0;
+        writer.Add(&result, 1);
+    }
     // Write the address out through our doorbell port
     m_doorbell.Write(address);
 }
 
-void SimpleApplication::AddInstruction(
-        const Instruction& instruction,
-        std::vector<hestia::IMemory::Data> &surface) {
-
-    auto encoded_values = FunctionalProcessorLibrary::Encode(instruction);
-    for (auto const& value : encoded_values) {
-        surface.emplace_back(value);
-    }
-}
-
 // 2 + 3 set result at memory location = 2
 Instruction SimpleApplication::CreateAddInstruction() {
     Instruction instruction{};
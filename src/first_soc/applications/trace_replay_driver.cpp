@@ -0,0 +1,98 @@
+#include "applications/trace_replay_driver.h"
+
+#include <timing/cycle.h>
+
+#include <algorithm>
+
+TraceReplayDriver::TraceReplayDriver(const hestia::ComponentInit &init) :
+        Manageable(hestia::FrameworkType::COMPONENT, init.name),
+        hestia::ProducerComponent<hestia::MemoryRequest>("requests", init),
+        // Ports
+        m_responses(CreatePortInit("responses")),
+        // Handlers
+        m_response_handler("response_handler", this, m_init),
+        // Parameters
+        m_reader(GetParam("trace_file")),
+        m_mode(ToMode(GetParam("mode"))),
+        // Counters
+        m_reads("reads", this, m_init),
+        m_writes("writes", this, m_init),
+        m_responses_received("responses", this, m_init),
+        m_read_latency_cycles("read_latency_cycles", this, m_init),
+        m_late_cycles("late_cycles", this, m_init) {
+
+    auto max_outstanding = GetParam("max_outstanding");
+    m_max_outstanding = max_outstanding.empty() ? 0 : std::stoull(max_outstanding);
+
+    m_response_handler.SetHandler(m_init, std::bind(&TraceReplayDriver::ResponseReturn, this));
+    m_response_handler << m_responses;
+}
+
+TraceReplayDriver::Mode TraceReplayDriver::ToMode(const std::string &name) {
+    if (name.empty() || name == "timed") {
+        return Mode::TIMED;
+    } else if (name == "back_pressure") {
+        return Mode::BACK_PRESSURE;
+    }
+    return Mode::INVALID;
+}
+
+bool TraceReplayDriver::Validate() const noexcept {
+    return m_reader.IsValid() && m_mode != Mode::INVALID;
+}
+
+void TraceReplayDriver::Setup() noexcept {
+    m_has_next = m_reader.Next(m_next);
+    m_first_cycle = m_next.cycle;
+    m_start_cycle = CurrentCycle(m_init);
+}
+
+void TraceReplayDriver::TearDown() noexcept {
+    if (m_reader.IsCorrupted()) {
+        m_logger.LogLn(hestia::LoggingType::WARNING, "Memory trace is truncated, replayed up to its last complete block");
+    }
+}
+
+bool TraceReplayDriver::HasWork() const noexcept {
+    if (!m_has_next || (m_max_outstanding != 0 && m_outstanding.size() >= m_max_outstanding)) {
+        return false;
+    }
+    return m_mode != Mode::TIMED || DueCycle() <= CurrentCycle(m_init);
+}
+
+hestia::MemoryRequest TraceReplayDriver::Produce() noexcept {
+    auto cycle = CurrentCycle(m_init);
+    hestia::MemoryRequest request{};
+    request.address = m_next.address;
+    request.size = m_next.size;
+    if (m_next.type == memory_trace::Type::WRITE) {
+        request.type = hestia::MemoryRequest::Type::WRITE;
+        request.data.assign(m_next.size, 0);
+        ++m_writes;
+    } else {
+        m_outstanding.emplace_back(m_next.address, cycle);
+        ++m_reads;
+    }
+    if (m_mode == Mode::TIMED) {
+        m_late_cycles += cycle - DueCycle();
+    }
+    m_has_next = m_reader.Next(m_next);
+    return request;
+}
+
+void TraceReplayDriver::ResponseReturn() {
+    auto cycle = CurrentCycle(m_init);
+    while (m_responses.ReadValid()) {
+        auto response = m_responses.Read();
+        // Responses to other requesters sharing the memory's response port are not ours to count
+        auto outstanding = std::find_if(m_outstanding.begin(), m_outstanding.end(), [&response](const auto& read) {
+            return read.first == response.request.address;
+        });
+        if (outstanding == m_outstanding.end()) {
+            continue;
+        }
+        m_read_latency_cycles += cycle - outstanding->second;
+        ++m_responses_received;
+        m_outstanding.erase(outstanding);
+    }
+}
@@ -1,6 +1,7 @@
 #include "functional_processor.h"
 
 #include <hestia/memory/memory_manager.h>
+#include <timing/cycle.h>
 
 FunctionalProcessor::FunctionalProcessor(const hestia::ComponentInit &init) :
         hestia::Manageable(hestia::FrameworkType::COMPONENT, init.name),
@@ -15,15 +16,24 @@ FunctionalProcessor::FunctionalProcessor(const hestia::ComponentInit &init) :
         m_memory(m_init.memories->GetMemory(GetParam("memory_name"))),
         // Counters
         m_memory_fetches("memory_fetches", this, m_init),
-        m_doorbell_rings("doorbell_rings", this, m_init) {
+        m_doorbell_rings("doorbell_rings", this, m_init),
+        m_events(GetParam("event_log_file"), ProcessorEventNames()),
+        // Reset
+        m_reset_handler(GetParam("reset_group"), std::bind(&FunctionalProcessor::Reset, this)) {
 
     m_doorbell_handler.SetHandler(m_init, std::bind(&FunctionalProcessor::CheckDoorbell, this));
     m_doorbell_handler << m_doorbell;
 }
 
+void FunctionalProcessor::Reset() {
+    m_functional_library.Reset();
+}
+
 void FunctionalProcessor::CheckDoorbell() {
     // Read our doorbell
-    m_functional_library.SetApplicationStart(m_doorbell.Read());
+    auto address = m_doorbell.Read();
+    LOG_EVENT(m_events, EventLevel::INFO, ProcessorEvent::DOORBELL, CurrentCycle(m_init), address);
+    m_functional_library.SetApplicationStart(address);
     ++m_doorbell_rings;
     // Run until hit ENDPRGRM
     while(true) {
@@ -38,6 +48,8 @@ void FunctionalProcessor::CheckDoorbell() {
         m_functional_library.ProcessOperandMemoryResponses(instruction, operand_responses);
         // Execute
         m_functional_library.Execute(instruction);
+        LOG_EVENT(m_events, EventLevel::DEBUG, ProcessorEvent::EXECUTED, CurrentCycle(m_init),
+                  static_cast<uint64_t>(instruction.opcode));
         // Write back result
         auto write_backs = m_functional_library.WriteBack(instruction);
         FetchMemory(write_backs);
@@ -2,6 +2,7 @@
 #include "memory_bound_processor.h"
 
 #include <hestia/memory/memory_manager.h>
+#include <timing/cycle.h>
 #include <functional/functional_processor_library.h>
 
 
@@ -26,7 +27,10 @@ MemoryBoundProcessor::MemoryBoundProcessor(const hestia::ComponentInit &init) :
         m_functional_library(init.name + ".functional", m_init),
         // Counters
         m_memory_fetches("memory_fetches", this, m_init),
-        m_doorbell_rings("doorbell_rings", this, m_init)  {
+        m_doorbell_rings("doorbell_rings", this, m_init),
+        m_events(GetParam("event_log_file"), ProcessorEventNames()),
+        // Reset
+        m_reset_handler(GetParam("reset_group"), std::bind(&MemoryBoundProcessor::Reset, this)) {
 
     m_doorbell_handler.SetHandler(m_init, std::bind(&MemoryBoundProcessor::CheckDoorbell, this));
     m_doorbell_handler << m_doorbell;
@@ -44,10 +48,18 @@ MemoryBoundProcessor::MemoryBoundProcessor(const hestia::ComponentInit &init) :
 
 }
 
+void MemoryBoundProcessor::Reset() {
+    m_functional_library.Reset();
+    m_operand_requests.clear();
+    m_write_back_requests.clear();
+}
+
 void MemoryBoundProcessor::CheckDoorbell() {
     // Read our doorbell
     ++m_doorbell_rings;
-    m_functional_library.SetApplicationStart(m_doorbell.Read());
+    auto address = m_doorbell.Read();
+    LOG_EVENT(m_events, EventLevel::INFO, ProcessorEvent::DOORBELL, CurrentCycle(m_init), address);
+    m_functional_library.SetApplicationStart(address);
     ++m_memory_fetches;
     m_instruction_fetch.Write(m_functional_library.Fetch());
 }
@@ -69,6 +81,7 @@ void MemoryBoundProcessor::InstructionReturn() {
     }
     // Check to see if we were back pressured and if so tell fifo to notify us when relieved.
     if(m_instruction_return.ReadValid() && !m_decoded_instruction_fifo.WriteValid()) {
+        LOG_EVENT(m_events, EventLevel::INFO, ProcessorEvent::EXECUTOR_BACK_PRESSURE, CurrentCycle(m_init));
         m_decoded_instruction_fifo.NotifyOnWriteable(m_instruction_return_handler.GetId());
     }
 }
@@ -82,6 +95,8 @@ void MemoryBoundProcessor::SendOperandRequests() {
     }
     // Check to see if we were back pressured and if so tell fifo to notify us when relieved.
     if (!m_operand_requests.empty()) {
+        LOG_EVENT(m_events, EventLevel::INFO, ProcessorEvent::OPERAND_BACK_PRESSURE, CurrentCycle(m_init),
+                  m_operand_requests.size());
         m_data_request.NotifyOnWriteable(m_operand_back_pressure_handler.GetId());
     }
 }
@@ -97,6 +112,8 @@ void MemoryBoundProcessor::OperandReturn() {
     if (m_decoded_instruction_fifo.ReadValid() && m_decoded_instruction_fifo.Peek().OperandsGathered()) {
         auto instruction = m_decoded_instruction_fifo.Read();
         m_functional_library.Execute(instruction);
+        LOG_EVENT(m_events, EventLevel::DEBUG, ProcessorEvent::EXECUTED, CurrentCycle(m_init),
+                  static_cast<uint64_t>(instruction.opcode));
         m_write_back_requests = std::move(m_functional_library.WriteBack(instruction));
         if(m_write_back_requests.empty()) {
             ++m_memory_fetches;
@@ -110,6 +127,8 @@ void MemoryBoundProcessor::OperandReturn() {
 void MemoryBoundProcessor::SendWriteBackRequests() {
     bool did_work = false;
     while(!m_write_back_requests.empty() && m_data_request.WriteValid()) {
+        LOG_EVENT(m_events, EventLevel::INFO, ProcessorEvent::WRITE_BACK_REQUESTED, CurrentCycle(m_init),
+                  m_write_back_requests.front().address);
         ++m_memory_fetches;
         m_data_request.Write(m_write_back_requests.front(), m_write_back_requests.front().size);
         m_write_back_requests.pop_front();
@@ -117,6 +136,8 @@ void MemoryBoundProcessor::SendWriteBackRequests() {
     }
     // Check to see if we processed all the results if not we were back pressured
     if (!m_write_back_requests.empty()) {
+        LOG_EVENT(m_events, EventLevel::INFO, ProcessorEvent::WRITE_BACK_REQUEST_BACK_PRESSURE, CurrentCycle(m_init),
+                  m_write_back_requests.size());
         m_data_request.NotifyOnWriteable(m_write_back_back_pressure_handler.GetId());
     } else if(did_work) { // If we did work and finished the instruction fetch the next one
         ++m_memory_fetches;
@@ -3,6 +3,10 @@
 
 #include <hestia/memory/memory_manager.h>
 #include <functional/functional_processor_library.h>
+#include <timing/cycle.h>
+
+#include <algorithm>
+#include <cassert>
 
 
 PerformantProcessor::PerformantProcessor(const hestia::ComponentInit &init) :
@@ -30,11 +34,19 @@ PerformantProcessor::PerformantProcessor(const hestia::ComponentInit &init) :
         m_executor_handler("executor_handler", this, m_init),
         m_write_back_handler("write_back_handler", this, m_init),
         m_write_back_back_pressure_handler("write_back_back_pressure_handler", this, m_init),
+        m_parked_handler("parked_handler", this, m_init),
         // Functional Library
-        m_functional_library(init.name + ".functional", m_init),
+        m_functional_library(init.name + ".functional", m_init, HardwareContexts::NumContexts(GetParam("num_contexts"))),
+        m_contexts("context", this, m_init, HardwareContexts::NumContexts(GetParam("num_contexts")), GetParam("fetch_policy")),
         // Counters
         m_memory_fetches("memory_fetches", this, m_init),
-        m_doorbell_rings("doorbell_rings", this, m_init)  {
+        m_doorbell_rings("doorbell_rings", this, m_init),
+        m_events(GetParam("event_log_file"), ProcessorEventNames()),
+        m_latencies("latency", this, m_init),
+        m_trace(init.name, GetParam("trace_file")),
+        m_profile(GetParam("profile_file")),
+        // Reset
+        m_reset_handler(GetParam("reset_group"), std::bind(&PerformantProcessor::Reset, this)) {
 
     m_doorbell_handler.SetHandler(m_init, std::bind(&PerformantProcessor::CheckDoorbell, this));
     m_doorbell_handler << m_doorbell;
@@ -63,21 +75,55 @@ PerformantProcessor::PerformantProcessor(const hestia::ComponentInit &init) :
 
     m_write_back_back_pressure_handler.SetHandler(m_init, std::bind(&PerformantProcessor::SendWriteBackRequests, this));
 
+    m_parked_handler.SetHandler(m_init, std::bind(&PerformantProcessor::IssueParked, this));
+
+}
+
+void PerformantProcessor::Reset() {
+    m_functional_library.Reset();
+    m_operand_requests.clear();
+    m_write_back_requests.clear();
+    m_contexts.Reset();
+    m_fetches.clear();
+    m_parked.clear();
+    m_write_back_blocked.clear();
+    m_return_cycle = 0;
+}
+
+void PerformantProcessor::TearDown() noexcept {
+    if (!m_trace.Write()) {
+        m_logger.LogLn(hestia::LoggingType::WARNING, "Failed to write pipeline trace");
+    }
+    if (m_profile.IsEnabled() && !m_profile.Write(m_init.memories->GetMemory(GetParam("memory_name")))) {
+        m_logger.LogLn(hestia::LoggingType::WARNING, "Failed to write profile");
+    }
 }
 
 void PerformantProcessor::CheckDoorbell() {
     // Read our doorbell
     ++m_doorbell_rings;
-    m_functional_library.SetApplicationStart(m_doorbell.Read());
+    auto address = m_doorbell.Read();
+    LOG_EVENT(m_events, EventLevel::INFO, ProcessorEvent::DOORBELL, CurrentCycle(m_init), address);
+    // Applications wait for a free context
+    m_contexts.Ring(address);
+    m_contexts.Start(m_functional_library);
     Fetch();
 }
 
 void PerformantProcessor::Fetch() {
-    if (m_fetcher.WriteValid()) {
-        m_fetcher.Write(m_functional_library.Fetch());
-    } else {
+    uint8_t context = 0;
+    // Every context has at most one instruction in flight
+    while (m_contexts.Select(context, 1) && m_fetcher.WriteValid()) {
+        m_fetches.emplace_back(context, CurrentCycle(m_init));
+        m_contexts.Fetched(context);
+        m_fetcher.Write(m_functional_library.Fetch(context));
+    }
+    auto back_pressured = m_contexts.Select(context, 1) && !m_fetcher.WriteValid();
+    if (back_pressured) {
+        LOG_EVENT(m_events, EventLevel::INFO, ProcessorEvent::FETCHER_BACK_PRESSURE, CurrentCycle(m_init));
         m_fetcher.NotifyOnWriteable(m_fetcher_back_pressure_handler.GetId());
     }
+    m_trace.BackPressured(PipelineTrace::BackPressure::FETCHER, back_pressured, CurrentCycle(m_init));
 }
 
 void PerformantProcessor::ProcessFetch() {
@@ -85,31 +131,60 @@ void PerformantProcessor::ProcessFetch() {
         ++m_memory_fetches;
         m_instruction_fetch.Write(m_fetcher.Read());
     }
-    if (m_fetcher.ReadValid() && !m_instruction_fetch.WriteValid()) {
+    auto back_pressured = m_fetcher.ReadValid() && !m_instruction_fetch.WriteValid();
+    if (back_pressured) {
+        LOG_EVENT(m_events, EventLevel::INFO, ProcessorEvent::INSTRUCTION_FETCH_BACK_PRESSURE, CurrentCycle(m_init));
         m_instruction_fetch.NotifyOnWriteable(m_fetcher_handler.GetId());
     }
+    m_trace.BackPressured(PipelineTrace::BackPressure::INSTRUCTION_FETCH, back_pressured, CurrentCycle(m_init));
 }
 
 void PerformantProcessor::InstructionReturn() {
     while (m_instruction_return.ReadValid() && m_decoder.WriteValid()) {
+        m_return_cycle = CurrentCycle(m_init);
         m_decoder.Write(m_instruction_return.Read());
     }
-    if (m_instruction_return.ReadValid() && !m_decoder.WriteValid()) {
+    auto back_pressured = m_instruction_return.ReadValid() && !m_decoder.WriteValid();
+    if (back_pressured) {
+        LOG_EVENT(m_events, EventLevel::INFO, ProcessorEvent::DECODER_BACK_PRESSURE, CurrentCycle(m_init));
         m_decoder.NotifyOnWriteable(m_instruction_return_handler.GetId());
     }
+    m_trace.BackPressured(PipelineTrace::BackPressure::DECODER, back_pressured, CurrentCycle(m_init));
 }
 
 void PerformantProcessor::Decode() {
     while (m_decoder.ReadValid() && m_executor.WriteValid()) {
         auto response = m_decoder.Read();
-        auto instruction = m_functional_library.Decode(response);
-        m_operand_requests = m_functional_library.GatherOperands(instruction);
-        m_executor.Write(instruction);
+        auto fetch = m_fetches.front();
+        m_fetches.pop_front();
+        auto instruction = m_functional_library.Decode(response, fetch.first);
+        if (instruction.opcode == Opcode::ENDPRGM) {
+            m_contexts.Terminate(instruction.context);
+        }
+        instruction.timestamps.fetched = fetch.second;
+        instruction.timestamps.returned = m_return_cycle;
+        instruction.timestamps.decoded = CurrentCycle(m_init);
+        // Nothing is held back by hazards here
+        instruction.timestamps.stalled = instruction.timestamps.decoded;
+        auto requests = m_functional_library.GatherOperands(instruction);
+        m_operand_requests.insert(m_operand_requests.end(), requests.begin(), requests.end());
+        if (instruction.OperandsGathered()) {
+            instruction.timestamps.gathered = instruction.timestamps.decoded;
+        }
+        if (!instruction.OperandsGathered() && m_contexts.size() > 1) {
+            // Park it so the other contexts keep issuing while the operands come back
+            m_parked.push_back(instruction);
+        } else {
+            m_executor.Write(instruction);
+        }
         SendOperandRequests();
     }
-    if(m_decoder.ReadValid() && !m_executor.WriteValid()) {
+    auto back_pressured = m_decoder.ReadValid() && !m_executor.WriteValid();
+    if(back_pressured) {
+        LOG_EVENT(m_events, EventLevel::INFO, ProcessorEvent::EXECUTOR_BACK_PRESSURE, CurrentCycle(m_init));
         m_executor.NotifyOnWriteable(m_decoder_handler.GetId());
     }
+    m_trace.BackPressured(PipelineTrace::BackPressure::EXECUTOR, back_pressured, CurrentCycle(m_init));
 }
 
 void PerformantProcessor::SendOperandRequests() {
@@ -118,9 +193,13 @@ void PerformantProcessor::SendOperandRequests() {
         m_data_request.Write(m_operand_requests.front(), m_operand_requests.front().size);
         m_operand_requests.pop_front();
     }
-    if (!m_operand_requests.empty()) {
+    auto back_pressured = !m_operand_requests.empty();
+    if (back_pressured) {
+        LOG_EVENT(m_events, EventLevel::INFO, ProcessorEvent::OPERAND_BACK_PRESSURE, CurrentCycle(m_init),
+                  m_operand_requests.size());
         m_data_request.NotifyOnWriteable(m_operand_back_pressure_handler.GetId());
     }
+    m_trace.BackPressured(PipelineTrace::BackPressure::OPERAND, back_pressured, CurrentCycle(m_init));
 }
 
 void PerformantProcessor::OperandReturn() {
@@ -128,30 +207,86 @@ void PerformantProcessor::OperandReturn() {
     while(m_data_return.ReadValid()) {
         responses.emplace_back(m_data_return.Read());
     }
+    if (!m_parked.empty()) {
+        GatherParked(responses);
+        return;
+    }
     m_functional_library.ProcessOperandMemoryResponses(m_executor.Peek(), responses);
     if (m_executor.Peek().OperandsGathered()) {
+        m_executor.Peek().timestamps.gathered = CurrentCycle(m_init);
         Execute();
     }
 }
 
+void PerformantProcessor::GatherParked(const std::deque<hestia::MemoryResponse>& responses) {
+    for (auto const& response : responses) {
+        // Memory answers in request order, so every response belongs to the oldest parked instruction still gathering
+        auto instruction = std::find_if(m_parked.begin(), m_parked.end(), [](const Instruction& parked) {
+            return !parked.OperandsGathered();
+        });
+        assert(instruction != m_parked.end());
+        std::deque<hestia::MemoryResponse> single{response};
+        m_functional_library.ProcessOperandMemoryResponses(*instruction, single);
+        if (instruction->OperandsGathered()) {
+            instruction->timestamps.gathered = CurrentCycle(m_init);
+        }
+    }
+    IssueParked();
+}
+
+void PerformantProcessor::IssueParked() {
+    while (!m_parked.empty() && m_parked.front().OperandsGathered() && m_executor.WriteValid()) {
+        m_executor.Write(m_parked.front());
+        m_parked.pop_front();
+    }
+    if (!m_parked.empty() && m_parked.front().OperandsGathered()) {
+        m_executor.NotifyOnWriteable(m_parked_handler.GetId());
+    }
+}
+
 void PerformantProcessor::Execute() {
     while (m_executor.ReadValid() && m_executor.Peek().OperandsGathered() && m_write_back.WriteValid()) {
         auto instruction = m_executor.Read();
         m_functional_library.Execute(instruction);
+        instruction.timestamps.executed = CurrentCycle(m_init);
+        if (instruction.timestamps.blocked == 0) {
+            instruction.timestamps.blocked = instruction.timestamps.executed;
+        }
+        LOG_EVENT(m_events, EventLevel::DEBUG, ProcessorEvent::EXECUTED, CurrentCycle(m_init),
+                  static_cast<uint64_t>(instruction.opcode));
         m_write_back.Write(instruction);
     }
-    if (m_executor.ReadValid() && m_executor.Peek().OperandsGathered() && !m_write_back.WriteValid()) {
+    auto back_pressured = m_executor.ReadValid() && m_executor.Peek().OperandsGathered() && !m_write_back.WriteValid();
+    if (back_pressured) {
+        if (m_executor.Peek().timestamps.blocked == 0) {
+            m_executor.Peek().timestamps.blocked = CurrentCycle(m_init);
+        }
+        LOG_EVENT(m_events, EventLevel::INFO, ProcessorEvent::WRITE_BACK_BACK_PRESSURE, CurrentCycle(m_init));
         m_executor.NotifyOnWriteable(m_executor_handler.GetId());
     }
+    m_trace.BackPressured(PipelineTrace::BackPressure::WRITE_BACK, back_pressured, CurrentCycle(m_init));
 }
 
 void PerformantProcessor::WriteBack() {
     while (m_write_back.ReadValid()) {
         auto instruction = m_write_back.Read();
-        m_write_back_requests = std::move(m_functional_library.WriteBack(instruction));
-        if(m_write_back_requests.empty() && instruction.opcode != Opcode::ENDPRGM) {
+        auto requests = m_functional_library.WriteBack(instruction);
+        instruction.timestamps.written_back = CurrentCycle(m_init);
+        m_latencies.Retire(instruction);
+        m_trace.Retire(instruction);
+        m_profile.Retire(instruction);
+        m_contexts.Retire(instruction);
+        // A finished application frees its context for the next queued doorbell
+        if (instruction.opcode == Opcode::ENDPRGM) {
+            m_contexts.Start(m_functional_library);
+        }
+        if(requests.empty()) {
             Fetch();
         } else {
+            // The context fetches again once its writes are out
+            m_contexts.Block(instruction.context);
+            m_write_back_blocked.push_back(instruction.context);
+            m_write_back_requests.insert(m_write_back_requests.end(), requests.begin(), requests.end());
             SendWriteBackRequests();
         }
     }
@@ -160,14 +295,24 @@ void PerformantProcessor::WriteBack() {
 void PerformantProcessor::SendWriteBackRequests() {
     bool did_work = false;
     while(!m_write_back_requests.empty() && m_data_request.WriteValid()) {
+        LOG_EVENT(m_events, EventLevel::INFO, ProcessorEvent::WRITE_BACK_REQUESTED, CurrentCycle(m_init),
+                  m_write_back_requests.front().address);
         ++m_memory_fetches;
         m_data_request.Write(m_write_back_requests.front(), m_write_back_requests.front().size);
         m_write_back_requests.pop_front();
         did_work = true;
     }
-    if (!m_write_back_requests.empty()) {
+    auto back_pressured = !m_write_back_requests.empty();
+    m_trace.BackPressured(PipelineTrace::BackPressure::WRITE_BACK_REQUEST, back_pressured, CurrentCycle(m_init));
+    if (back_pressured) {
+        LOG_EVENT(m_events, EventLevel::INFO, ProcessorEvent::WRITE_BACK_REQUEST_BACK_PRESSURE, CurrentCycle(m_init),
+                  m_write_back_requests.size());
         m_data_request.NotifyOnWriteable(m_write_back_back_pressure_handler.GetId());
     } else if(did_work) {
+        for (auto context : m_write_back_blocked) {
+            m_contexts.Unblock(context);
+        }
+        m_write_back_blocked.clear();
         Fetch();
     }
 }
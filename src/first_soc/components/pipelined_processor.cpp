@@ -2,6 +2,10 @@
 
 #include <hestia/memory/memory_manager.h>
 #include <functional/functional_processor_library.h>
+#include <timing/cycle.h>
+
+#include <algorithm>
+#include <cassert>
 
 
 PipelinedProcessor::PipelinedProcessor(const hestia::ComponentInit &init) :
@@ -29,11 +33,19 @@ PipelinedProcessor::PipelinedProcessor(const hestia::ComponentInit &init) :
         m_executor_handler("executor_handler", this, m_init),
         m_write_back_handler("write_back_handler", this, m_init),
         m_write_back_back_pressure_handler("write_back_back_pressure_handler", this, m_init),
+        m_parked_handler("parked_handler", this, m_init),
         // Functional Library
-        m_functional_library(init.name + ".functional", m_init),
+        m_functional_library(init.name + ".functional", m_init, HardwareContexts::NumContexts(GetParam("num_contexts"))),
+        m_contexts("context", this, m_init, HardwareContexts::NumContexts(GetParam("num_contexts")), GetParam("fetch_policy")),
         // Counters
         m_memory_fetches("memory_fetches", this, m_init),
-        m_doorbell_rings("doorbell_rings", this, m_init)  {
+        m_doorbell_rings("doorbell_rings", this, m_init),
+        m_events(GetParam("event_log_file"), ProcessorEventNames()),
+        m_latencies("latency", this, m_init),
+        m_trace(init.name, GetParam("trace_file")),
+        m_profile(GetParam("profile_file")),
+        // Reset
+        m_reset_handler(GetParam("reset_group"), std::bind(&PipelinedProcessor::Reset, this)) {
 
     m_doorbell_handler.SetHandler(m_init, std::bind(&PipelinedProcessor::CheckDoorbell, this));
     m_doorbell_handler << m_doorbell;
@@ -64,103 +76,179 @@ PipelinedProcessor::PipelinedProcessor(const hestia::ComponentInit &init) :
 
     m_write_back_back_pressure_handler.SetHandler(m_init, std::bind(&PipelinedProcessor::SendWriteBackRequests, this));
 
+    m_parked_handler.SetHandler(m_init, std::bind(&PipelinedProcessor::IssueParked, this));
+
+}
+
+void PipelinedProcessor::Reset() {
+    m_functional_library.Reset();
+    m_operand_requests.clear();
+    m_write_back_requests.clear();
+    m_destination_registers.clear();
+    m_destination_addresses.clear();
+    m_destination_vector_registers.clear();
+    m_contexts.Reset();
+    m_fetch_contexts.clear();
+    m_parked.clear();
+    m_fetch_cycle = 0;
+    m_return_cycle = 0;
+    m_hazard_stalled = false;
+}
+
+void PipelinedProcessor::TearDown() noexcept {
+    if (!m_trace.Write()) {
+        m_logger.LogLn(hestia::LoggingType::WARNING, "Failed to write pipeline trace");
+    }
+    if (m_profile.IsEnabled() && !m_profile.Write(m_init.memories->GetMemory(GetParam("memory_name")))) {
+        m_logger.LogLn(hestia::LoggingType::WARNING, "Failed to write profile");
+    }
 }
 
 void PipelinedProcessor::CheckDoorbell() {
     // Read our doorbell
     ++m_doorbell_rings;
-    m_functional_library.SetApplicationStart(m_doorbell.Read());
-    application_terminated = false;
+    auto address = m_doorbell.Read();
+    LOG_EVENT(m_events, EventLevel::INFO, ProcessorEvent::DOORBELL, CurrentCycle(m_init), address);
+    // Applications wait for a free context
+    m_contexts.Ring(address);
+    m_contexts.Start(m_functional_library);
     Fetch();
 }
 
 void PipelinedProcessor::Fetch() {
-    if (m_fetcher.WriteValid() && !application_terminated) {
-        m_logger.LogLn(hestia::LoggingType::INFO, "Sending To Fetcher");
-        m_fetcher.Write(m_functional_library.Fetch());
+    uint8_t context = 0;
+    if (!m_contexts.Select(context)) {
+        // Every context is idle, branching or waiting on operands
+        return;
+    }
+    if (m_fetcher.WriteValid()) {
+        LOG_EVENT(m_events, EventLevel::INFO, ProcessorEvent::SENT_TO_FETCHER, CurrentCycle(m_init));
+        m_fetch_cycle = CurrentCycle(m_init);
+        m_fetch_contexts.push_back(context);
+        m_contexts.Fetched(context);
+        m_fetcher.Write(m_functional_library.Fetch(context));
     } else {
-        m_logger.LogLn(hestia::LoggingType::INFO, "Back pressured by fetcher");
+        LOG_EVENT(m_events, EventLevel::INFO, ProcessorEvent::FETCHER_BACK_PRESSURE, CurrentCycle(m_init));
         m_fetcher.NotifyOnWriteable(m_fetcher_back_pressure_handler.GetId());
     }
+    m_trace.BackPressured(PipelineTrace::BackPressure::FETCHER, !m_fetcher.WriteValid(), CurrentCycle(m_init));
 }
 
 void PipelinedProcessor::ProcessFetch() {
     if (m_fetcher.ReadValid() && m_fetcher.Peek().status == hestia::MemoryRequest::Status::PENDING && m_instruction_fetch.WriteValid()) {
-        m_logger.LogLn(hestia::LoggingType::INFO, "Fetching");
+        LOG_EVENT(m_events, EventLevel::INFO, ProcessorEvent::INSTRUCTION_REQUESTED, CurrentCycle(m_init), m_fetcher.Peek().address);
         ++m_memory_fetches;
         m_fetcher.Peek().status = hestia::MemoryRequest::Status::SENT;
         m_instruction_fetch.Write(m_fetcher.Peek());
     }
-    if (m_fetcher.ReadValid() && !m_instruction_fetch.WriteValid()) {
-        m_logger.LogLn(hestia::LoggingType::INFO, "Back Pressured by instruction fetch");
+    auto back_pressured = m_fetcher.ReadValid() && !m_instruction_fetch.WriteValid();
+    if (back_pressured) {
+        LOG_EVENT(m_events, EventLevel::INFO, ProcessorEvent::INSTRUCTION_FETCH_BACK_PRESSURE, CurrentCycle(m_init));
         m_instruction_fetch.NotifyOnWriteable(m_fetcher_handler.GetId());
     }
+    m_trace.BackPressured(PipelineTrace::BackPressure::INSTRUCTION_FETCH, back_pressured, CurrentCycle(m_init));
 }
 
 void PipelinedProcessor::InstructionReturn() {
     while (m_instruction_return.ReadValid() && m_fetcher.ReadValid() && m_decoder.WriteValid()) {
-        m_logger.LogLn(hestia::LoggingType::INFO, "Sending to Decoder");
+        LOG_EVENT(m_events, EventLevel::INFO, ProcessorEvent::SENT_TO_DECODER, CurrentCycle(m_init));
+        m_return_cycle = CurrentCycle(m_init);
         m_decoder.Write(m_instruction_return.Read());
     }
-    if (m_instruction_return.ReadValid() && !m_decoder.WriteValid()) {
-        m_logger.LogLn(hestia::LoggingType::INFO, "Back pressured by decoder");
+    auto back_pressured = m_instruction_return.ReadValid() && !m_decoder.WriteValid();
+    if (back_pressured) {
+        LOG_EVENT(m_events, EventLevel::INFO, ProcessorEvent::DECODER_BACK_PRESSURE, CurrentCycle(m_init));
         m_decoder.NotifyOnWriteable(m_instruction_return_handler.GetId());
     }
+    m_trace.BackPressured(PipelineTrace::BackPressure::DECODER, back_pressured, CurrentCycle(m_init));
 }
 
 void PipelinedProcessor::Decode() {
     while (m_decoder.ReadValid() && m_fetcher.ReadValid() && m_operand_requests.empty() && m_executor.WriteValid()) {
         auto response = m_decoder.Peek();
-        auto instruction = m_functional_library.Decode(response);
+        auto context = m_fetch_contexts.front();
+        auto instruction = m_functional_library.Decode(response, context);
         if(instruction.opcode == Opcode::ENDPRGM) {
-            application_terminated = true;
+            m_contexts.Terminate(context);
         }
 
         if(HazardCheck(instruction)) {
             m_decoder.Read();
             m_fetcher.Read();
+            m_fetch_contexts.pop_front();
+            instruction.timestamps.fetched = m_fetch_cycle;
+            instruction.timestamps.returned = m_return_cycle;
+            instruction.timestamps.decoded = CurrentCycle(m_init);
+            instruction.timestamps.stalled = m_hazard_stalled ? m_stalled_cycle : instruction.timestamps.decoded;
+            m_hazard_stalled = false;
             m_operand_requests = m_functional_library.GatherOperands(instruction);
-            m_executor.Write(instruction);
+            if (instruction.OperandsGathered()) {
+                instruction.timestamps.gathered = instruction.timestamps.decoded;
+            }
             switch(instruction.result.type) {
                 case Result::Type::NONE:
                     break;
                 case Result::Type::REGISTER:
-                    m_destination_registers.emplace_back(instruction.result.location);
+                    m_destination_registers.emplace_back(context, instruction.result.location);
                     break;
                 case Result::Type::MEMORY:
-                    m_destination_addresses.emplace_back(instruction.result.location);
+                case Result::Type::INDIRECT_MEMORY_REGISTER: // Already resolved to an address when gathered
+                    // Vector results write a whole vector, every word is tracked
+                    for (uint64_t i = 0; i < m_functional_library.GetResultSize(instruction.opcode); i++) {
+                        m_destination_addresses.emplace_back(instruction.result.location + i);
+                    }
+                    break;
+                case Result::Type::VECTOR_REGISTER:
+                    m_destination_vector_registers.emplace_back(context, instruction.result.location);
                     break;
             }
-            m_logger.LogLn(hestia::LoggingType::INFO, "Sending to executor");
-            SendOperandRequests();
-            if (GetDetails(instruction.opcode).type != OpcodeDetails::Type::BRANCH) {
-                m_logger.LogLn(hestia::LoggingType::INFO, "Fetching because of branch");
-                Fetch();
+            auto is_branch = GetDetails(instruction.opcode).type == OpcodeDetails::Type::BRANCH;
+            if (is_branch) {
+                m_contexts.Block(context);
+            }
+            if (!instruction.OperandsGathered() && m_contexts.size() > 1) {
+                // Park it so the other contexts keep issuing while the operands come back
+                m_contexts.Block(context);
+                m_parked.push_back(instruction);
             } else {
-                m_logger.LogLn(hestia::LoggingType::INFO, "Branching");
+                m_executor.Write(instruction);
+            }
+            LOG_EVENT(m_events, EventLevel::INFO, ProcessorEvent::SENT_TO_EXECUTOR, CurrentCycle(m_init), static_cast<uint64_t>(instruction.opcode));
+            SendOperandRequests();
+            if (is_branch) {
+                LOG_EVENT(m_events, EventLevel::INFO, ProcessorEvent::BRANCHING, CurrentCycle(m_init), static_cast<uint64_t>(instruction.opcode));
             }
+            Fetch();
         } else {
-            m_logger.LogLn(hestia::LoggingType::INFO, "Hit Memory Hazard Stalling");
+            LOG_EVENT(m_events, EventLevel::INFO, ProcessorEvent::HAZARD_STALL, CurrentCycle(m_init), static_cast<uint64_t>(instruction.opcode));
+            if (!m_hazard_stalled) {
+                m_hazard_stalled = true;
+                m_stalled_cycle = CurrentCycle(m_init);
+            }
             break;
         }
     }
-    if(m_decoder.ReadValid() && !m_executor.WriteValid()) {
-        m_logger.LogLn(hestia::LoggingType::INFO, "Back pressured by executor");
+    auto back_pressured = m_decoder.ReadValid() && !m_executor.WriteValid();
+    if(back_pressured) {
+        LOG_EVENT(m_events, EventLevel::INFO, ProcessorEvent::EXECUTOR_BACK_PRESSURE, CurrentCycle(m_init));
         m_executor.NotifyOnWriteable(m_decoder_handler.GetId());
     }
+    m_trace.BackPressured(PipelineTrace::BackPressure::EXECUTOR, back_pressured, CurrentCycle(m_init));
 }
 
 void PipelinedProcessor::SendOperandRequests() {
     while (!m_operand_requests.empty() && m_data_request.WriteValid()) {
-        m_logger.LogLn(hestia::LoggingType::INFO, "Requesting Operand");
+        LOG_EVENT(m_events, EventLevel::INFO, ProcessorEvent::OPERAND_REQUESTED, CurrentCycle(m_init), m_operand_requests.front().address);
         ++m_memory_fetches;
         m_data_request.Write(m_operand_requests.front(), m_operand_requests.front().size);
         m_operand_requests.pop_front();
     }
-    if (!m_operand_requests.empty()) {
-        m_logger.LogLn(hestia::LoggingType::INFO, "Back Pressured Waiting on Operand");
+    auto back_pressured = !m_operand_requests.empty();
+    if (back_pressured) {
+        LOG_EVENT(m_events, EventLevel::INFO, ProcessorEvent::OPERAND_BACK_PRESSURE, CurrentCycle(m_init), m_operand_requests.size());
         m_data_request.NotifyOnWriteable(m_operand_back_pressure_handler.GetId());
     }
+    m_trace.BackPressured(PipelineTrace::BackPressure::OPERAND, back_pressured, CurrentCycle(m_init));
 }
 
 void PipelinedProcessor::OperandReturn() {
@@ -168,59 +256,136 @@ void PipelinedProcessor::OperandReturn() {
     while(m_data_return.ReadValid()) {
         responses.emplace_back(m_data_return.Read());
     }
-    m_logger.LogLn(hestia::LoggingType::INFO, "Received Operands");
+    LOG_EVENT(m_events, EventLevel::INFO, ProcessorEvent::OPERANDS_RECEIVED, CurrentCycle(m_init), responses.size());
+    if (!m_parked.empty()) {
+        GatherParked(responses);
+        return;
+    }
     m_functional_library.ProcessOperandMemoryResponses(m_executor.Peek(), responses);
     if (m_executor.Peek().OperandsGathered()) {
+        m_executor.Peek().timestamps.gathered = CurrentCycle(m_init);
         Execute();
     }
 }
 
+void PipelinedProcessor::GatherParked(const std::deque<hestia::MemoryResponse>& responses) {
+    for (auto const& response : responses) {
+        // Memory answers in request order, so every response belongs to the oldest parked instruction still gathering
+        auto instruction = std::find_if(m_parked.begin(), m_parked.end(), [](const Instruction& parked) {
+            return !parked.OperandsGathered();
+        });
+        assert(instruction != m_parked.end());
+        std::deque<hestia::MemoryResponse> single{response};
+        m_functional_library.ProcessOperandMemoryResponses(*instruction, single);
+        if (instruction->OperandsGathered()) {
+            instruction->timestamps.gathered = CurrentCycle(m_init);
+        }
+    }
+    IssueParked();
+}
+
+void PipelinedProcessor::IssueParked() {
+    while (!m_parked.empty() && m_parked.front().OperandsGathered() && m_executor.WriteValid()) {
+        auto context = m_parked.front().context;
+        m_executor.Write(m_parked.front());
+        m_parked.pop_front();
+        m_contexts.Unblock(context);
+    }
+    if (!m_parked.empty() && m_parked.front().OperandsGathered()) {
+        m_executor.NotifyOnWriteable(m_parked_handler.GetId());
+    }
+    Fetch();
+}
+
 void PipelinedProcessor::Execute() {
     while (m_executor.ReadValid() && m_executor.Peek().OperandsGathered() && m_write_back.WriteValid()) {
         auto instruction = m_executor.Read();
         m_functional_library.Execute(instruction);
+        instruction.timestamps.executed = CurrentCycle(m_init);
+        if (instruction.timestamps.blocked == 0) {
+            instruction.timestamps.blocked = instruction.timestamps.executed;
+        }
         m_write_back.Write(instruction);
-        m_logger.LogLn(hestia::LoggingType::INFO, "Executed");
+        LOG_EVENT(m_events, EventLevel::INFO, ProcessorEvent::EXECUTED, CurrentCycle(m_init), static_cast<uint64_t>(instruction.opcode));
         if(GetDetails(instruction.opcode).type == OpcodeDetails::Type::BRANCH) {
+            m_contexts.Unblock(instruction.context);
             Fetch();
         }
     }
-    if (m_executor.ReadValid() && m_executor.Peek().OperandsGathered() && !m_write_back.WriteValid()) {
-        m_logger.LogLn(hestia::LoggingType::INFO, "Back Pressured by Write Back");
+    auto back_pressured = m_executor.ReadValid() && m_executor.Peek().OperandsGathered() && !m_write_back.WriteValid();
+    if (back_pressured) {
+        if (m_executor.Peek().timestamps.blocked == 0) {
+            m_executor.Peek().timestamps.blocked = CurrentCycle(m_init);
+        }
+        LOG_EVENT(m_events, EventLevel::INFO, ProcessorEvent::WRITE_BACK_BACK_PRESSURE, CurrentCycle(m_init));
         m_executor.NotifyOnWriteable(m_executor_handler.GetId());
     }
+    m_trace.BackPressured(PipelineTrace::BackPressure::WRITE_BACK, back_pressured, CurrentCycle(m_init));
 }
 
 void PipelinedProcessor::WriteBack() {
     while (m_write_back.ReadValid()) {
         auto instruction = m_write_back.Read();
-        m_write_back_requests = std::move(m_functional_library.WriteBack(instruction));
-        m_logger.LogLn(hestia::LoggingType::INFO, "Written Back");
+        auto requests = m_functional_library.WriteBack(instruction);
+        m_write_back_requests.insert(m_write_back_requests.end(), requests.begin(), requests.end());
+        instruction.timestamps.written_back = CurrentCycle(m_init);
+        m_latencies.Retire(instruction);
+        m_trace.Retire(instruction);
+        m_profile.Retire(instruction);
+        m_contexts.Retire(instruction);
+        LOG_EVENT(m_events, EventLevel::INFO, ProcessorEvent::WRITTEN_BACK, CurrentCycle(m_init), static_cast<uint64_t>(instruction.opcode));
         SendWriteBackRequests();
+        // Contexts retire out of order with each other, so remove this instruction's own entries
         switch(instruction.result.type) {
             case Result::Type::NONE:
                 break;
             case Result::Type::REGISTER:
-                m_destination_registers.pop_front();
+                Erase(m_destination_registers, {instruction.context, instruction.result.location});
                 Decode();
                 break;
             case Result::Type::MEMORY:
-                m_destination_addresses.pop_front();
+            case Result::Type::INDIRECT_MEMORY_REGISTER:
+                for (uint64_t i = 0; i < m_functional_library.GetResultSize(instruction.opcode); i++) {
+                    Erase<hestia::IMemory::Address>(m_destination_addresses, instruction.result.location + i);
+                }
+                Decode();
+                break;
+            case Result::Type::VECTOR_REGISTER:
+                Erase(m_destination_vector_registers, {instruction.context, instruction.result.location});
                 Decode();
                 break;
         }
+        // A finished application frees its context for the next queued doorbell
+        if (instruction.opcode == Opcode::ENDPRGM && m_contexts.Start(m_functional_library)) {
+            Fetch();
+        }
+    }
+}
+
+template <typename T>
+void PipelinedProcessor::Erase(std::deque<T>& destinations, const T& destination) {
+    // Missing after a Reset with instructions in flight
+    auto found = std::find(destinations.begin(), destinations.end(), destination);
+    if (found != destinations.end()) {
+        destinations.erase(found);
     }
 }
 
 void PipelinedProcessor::SendWriteBackRequests() {
     while(!m_write_back_requests.empty() && m_data_request.WriteValid()) {
+        LOG_EVENT(m_events, EventLevel::INFO, ProcessorEvent::WRITE_BACK_REQUESTED, CurrentCycle(m_init),
+                  m_write_back_requests.front().address);
         ++m_memory_fetches;
         m_data_request.Write(m_write_back_requests.front(), m_write_back_requests.front().size);
         m_write_back_requests.pop_front();
     }
-    if (!m_write_back_requests.empty()) {
+    auto back_pressured = !m_write_back_requests.empty();
+    if (back_pressured) {
+        LOG_EVENT(m_events, EventLevel::INFO, ProcessorEvent::WRITE_BACK_REQUEST_BACK_PRESSURE, CurrentCycle(m_init),
+                  m_write_back_requests.size());
         m_data_request.NotifyOnWriteable(m_write_back_back_pressure_handler.GetId());
     }
+    m_trace.BackPressured(PipelineTrace::BackPressure::WRITE_BACK_REQUEST, back_pressured, CurrentCycle(m_init));
 }
 
 bool PipelinedProcessor::HazardCheck(const Instruction& instruction) {
@@ -228,7 +393,7 @@ bool PipelinedProcessor::HazardCheck(const Instruction& instruction) {
         switch (op.type) {
             case Operand::Type::REGISTER: {
                 for (auto &destination_register : m_destination_registers) {
-                    if (destination_register == op.location) {
+                    if (destination_register == Destination{instruction.context, op.location}) {
                         return false;
                     }
                 }
@@ -236,20 +401,39 @@ bool PipelinedProcessor::HazardCheck(const Instruction& instruction) {
             }
             case Operand::Type::CONSTANT:
                 break;
-            case Operand::Type::INDIRECT_MEMORY_REGISTER:
+            case Operand::Type::INDIRECT_MEMORY_REGISTER: {
                 for (auto &destination_register : m_destination_registers) {
-                    if (destination_register == op.location) {
+                    if (destination_register == Destination{instruction.context, op.location}) {
                         return false;
                     }
                 }
+                // Vector opcodes read a whole vector starting at the address, memory is shared by every context
+                auto address = m_functional_library.GetRegister(op.location, instruction.context);
+                auto size = m_functional_library.GetOperandSize(instruction.opcode);
                 for (auto& destination_address : m_destination_addresses) {
-                    if (destination_address == m_destination_registers[op.location]) {
+                    if (destination_address >= address && destination_address < address + size) {
                         return false;
                     }
                 }
                 break;
+            }
             case Operand::Type::EMBEDDED:
                 break;
+            case Operand::Type::VECTOR_REGISTER:
+                for (auto &destination_register : m_destination_vector_registers) {
+                    if (destination_register == Destination{instruction.context, op.location}) {
+                        return false;
+                    }
+                }
+                break;
+        }
+    }
+    // An indirect destination reads its address register when gathered
+    if (instruction.result.type == Result::Type::INDIRECT_MEMORY_REGISTER) {
+        for (auto &destination_register : m_destination_registers) {
+            if (destination_register == Destination{instruction.context, instruction.result.location}) {
+                return false;
+            }
         }
     }
     return true;
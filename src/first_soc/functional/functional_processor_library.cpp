@@ -1,48 +1,110 @@
 #include "functional_processor_library.h"
 
 #include <hestia/parameter/parameter_manager.h>
+#include <timing/cycle.h>
 
+#include <algorithm>
 #include <cassert>
+#include <cstring>
+#include <limits>
 #include <utility>
 
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+
 static const auto FrameworkType = hestia::FrameworkType::COMPONENT;
 
 static const auto MAX_OPERANDS = 2;
 
-FunctionalProcessorLibrary::FunctionalProcessorLibrary(std::string name, const hestia::Init &init) :
+// Counter names of the Operand::Type and Result::Type values, in enum order
+static const char* const OPERAND_TYPE_NAMES[] = {"registers", "constants", "indirect_memories", "embedded", "vector_registers"};
+static const char* const RESULT_TYPE_NAMES[] = {"none", "registers", "memories", "indirect_memories", "vector_registers"};
+static constexpr uint8_t NO_MIX_INDEX = 0xFFu;
+
+/**
+ * Unsigned parameter of the library, or its default when the parameter was never set so configs
+ * written before the parameter existed keep working
+ */
+static uint64_t GetUintParam(const hestia::Init& init, const std::string& name, const std::string& key,
+                             uint64_t default_value) {
+    auto value = init.params->GetParam(FrameworkType, name, key);
+    return value.empty() ? default_value : std::stoull(value);
+}
+
+FunctionalProcessorLibrary::FunctionalProcessorLibrary(std::string name, const hestia::Init &init, uint64_t num_contexts) :
     hestia::Manageable(FrameworkType, std::move(name)),
-    m_registers(init.params->GetUintParam(FrameworkType, GetName(), "num_registers")),
     m_counters(GetName(), this, init),
-    m_logger(hestia::LoggerInit{*init.logging_manager, FrameworkType, GetName()}),
-    m_instruction_trace(hestia::LoggerInit{*init.logging_manager, FrameworkType, GetName() + ".instructions"}) {
-
+    m_vector_length(GetUintParam(init, GetName(), "vector_length", DEFAULT_VECTOR_LENGTH)),
+    m_contexts(num_contexts <= MAX_CONTEXTS ? num_contexts : 0),
+    m_init(init),
+    m_events(init.params->GetParam(FrameworkType, GetName(), "event_log_file"), FunctionalEventNames()) {
+    auto num_registers = init.params->GetUintParam(FrameworkType, GetName(), "num_registers");
+    auto num_vector_registers = GetUintParam(init, GetName(), "num_vector_registers", DEFAULT_NUM_VECTOR_REGISTERS);
+    for (auto& context : m_contexts) {
+        context.registers.resize(num_registers);
+        context.vector_registers.resize(num_vector_registers * m_vector_length);
+    }
 }
 
-void FunctionalProcessorLibrary::SetApplicationStart(hestia::IMemory::Address address) {
-    assert(m_program_counter == 0);
+void FunctionalProcessorLibrary::SetApplicationStart(hestia::IMemory::Address address, uint8_t context) {
+    assert(!IsRunning(context));
     ++m_counters.applications.started;
-    m_program_counter = address;
-    m_logger.Log(hestia::LoggingType::INFO, "Received Doorbell for application at address: ");
-    m_logger.LogLn(hestia::LoggingType::INFO, std::to_string(m_program_counter).c_str());
-    m_instruction_trace.LogLn(hestia::LoggingType::DEBUG,
-                              "Opcode  |  Operand 0 (Type) (Location) | Operand 1 (Type) (Location) | "
-                              "Result (Type) (Location) | Flags before | Flags after");
+    m_contexts[context].program_counter = address;
+    LOG_EVENT(m_events, EventLevel::INFO, FunctionalEvent::APPLICATION_STARTED, CurrentCycle(m_init), address);
+}
+
+void FunctionalProcessorLibrary::Reset() {
+    for (auto& context : m_contexts) {
+        context.program_counter = 0;
+        std::fill(context.registers.begin(), context.registers.end(), 0);
+        context.flags = {};
+        context.call_stack.clear();
+        context.extensions = {};
+        context.extended = 0;
+        std::fill(context.vector_registers.begin(), context.vector_registers.end(), 0);
+    }
 }
 
 
-hestia::MemoryRequest FunctionalProcessorLibrary::Fetch() {
+hestia::MemoryRequest FunctionalProcessorLibrary::Fetch(uint8_t context) {
     hestia::MemoryRequest request{};
-    request.address = m_program_counter;
+    request.address = m_contexts[context].program_counter;
     request.size = 1;
     ++m_counters.instructions.fetched;
-    m_logger.Log(hestia::LoggingType::DEBUG, "Fetching instruction at address: ");
-    m_logger.LogLn(hestia::LoggingType::DEBUG, std::to_string(m_program_counter).c_str());
+    LOG_EVENT(m_events, EventLevel::DEBUG, FunctionalEvent::FETCHED, CurrentCycle(m_init), request.address);
     return request;
 }
 
 
-Instruction FunctionalProcessorLibrary::Decode(const hestia::MemoryResponse& response) {
-    auto instruction = response.data[0];
+Instruction FunctionalProcessorLibrary::Decode(const hestia::MemoryResponse& response, uint8_t context) {
+    auto instruction = Decode(response.data[0]);
+    instruction.context = context;
+    instruction.address = response.request.address;
+    if (m_contexts[context].extended != 0 && instruction.opcode != Opcode::EXTEND) {
+        ApplyExtensions(instruction);
+    }
+    return instruction;
+}
+
+void FunctionalProcessorLibrary::ApplyExtensions(Instruction &instruction) const {
+    const auto& context = m_contexts[instruction.context];
+    for (size_t i = 0; i < instruction.operands.size(); i++) {
+        if ((context.extended >> i) & 1u) {
+            auto& operand = instruction.operands[i];
+            if (operand.type == Operand::Type::EMBEDDED) {
+                operand.value = static_cast<int64_t>(context.extensions[i]);
+            } else {
+                operand.location = context.extensions[i];
+            }
+        }
+    }
+    if ((context.extended >> EXTEND_RESULT) & 1u) {
+        instruction.result.location = context.extensions[EXTEND_RESULT];
+    }
+}
+
+Instruction FunctionalProcessorLibrary::Decode(uint64_t instruction) {
     Instruction result{};
     result.opcode = static_cast<Opcode>(static_cast<uint16_t>(instruction));
     result.operands.resize(GetDetails(result.opcode).num_operands);
@@ -65,50 +127,141 @@ Instruction FunctionalProcessorLibrary::Decode(const hestia::MemoryResponse& res
                 result.operands[i].value = meta_data;
                 result.operands[i].status = Operand::Status::GATHERED;
                 break;
+            case Operand::Type::VECTOR_REGISTER:
+                result.operands[i].location = meta_data;
+                break;
         }
     }
-    result.result.type = operand_types[16] ? Result::Type::REGISTER : Result::Type::NONE;
-    result.result.type = operand_types[17] ? Result::Type::MEMORY : result.result.type;
+    // Bit 16 marks a register, bit 17 memory, both an indirect memory register and bit 18 a vector register
+    result.result.type = static_cast<Result::Type>((operand_types.to_ulong() >> 16u) & 0x7u);
     result.result.location = (operand_meta_data.to_ulong() >> 16u) & 0xFFu;
     return result;
 }
 
+#ifdef __AVX2__
+/**
+ * After the two byte opcode every field of an encoded word is one byte, so decoding four words is a
+ * byte transpose: group each field's bytes within the 128 bit lanes, interleave the lanes and group
+ * again. That leaves the four opcodes followed by four bytes per field, in encoding order.
+ * @return Number of instructions decoded, a multiple of four
+ */
+static size_t DecodeFields(const uint64_t* words, InstructionBatch& batch) {
+    const auto group = _mm256_setr_epi8(0, 1, 8, 9, 2, 10, 3, 11, 4, 12, 5, 13, 6, 14, 7, 15,
+                                        0, 1, 8, 9, 2, 10, 3, 11, 4, 12, 5, 13, 6, 14, 7, 15);
+    const auto interleave = _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7);
+    const auto regroup = _mm256_setr_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 12, 13, 10, 11, 14, 15,
+                                          0, 1, 4, 5, 2, 3, 6, 7, 8, 9, 12, 13, 10, 11, 14, 15);
+    alignas(32) uint8_t fields[32];
+    size_t i = 0;
+    for (; i + 4 <= batch.size(); i += 4) {
+        auto offsets = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&batch.offsets[i]));
+        auto encoded = _mm256_i32gather_epi64(reinterpret_cast<const long long*>(words), offsets, 8);
+        encoded = _mm256_shuffle_epi8(encoded, group);
+        encoded = _mm256_permutevar8x32_epi32(encoded, interleave);
+        encoded = _mm256_shuffle_epi8(encoded, regroup);
+        _mm256_store_si256(reinterpret_cast<__m256i*>(fields), encoded);
+        std::memcpy(&batch.opcodes[i], fields, 8);
+        std::memcpy(&batch.operand_types[0][i], fields + 8, 4);
+        std::memcpy(&batch.operand_types[1][i], fields + 12, 4);
+        std::memcpy(&batch.result_types[i], fields + 16, 4);
+        std::memcpy(&batch.operand_meta_data[0][i], fields + 20, 4);
+        std::memcpy(&batch.operand_meta_data[1][i], fields + 24, 4);
+        std::memcpy(&batch.result_locations[i], fields + 28, 4);
+    }
+    return i;
+}
+#else
+static size_t DecodeFields(const uint64_t*, InstructionBatch&) {
+    return 0;
+}
+#endif
+
+size_t FunctionalProcessorLibrary::Decode(const uint64_t* words, size_t num_words, InstructionBatch& batch) {
+    // Instruction boundaries depend on the constant operands before them, so they are found serially
+    const auto constant = static_cast<uint64_t>(Operand::Type::CONSTANT);
+    batch.offsets.resize(num_words);
+    size_t count = 0;
+    size_t offset = 0;
+    while (offset < num_words) {
+        auto word = words[offset];
+        auto size = 1 + (((word >> 16u) & 0xFFu) == constant) + (((word >> 24u) & 0xFFu) == constant);
+        if (offset + size > num_words) {
+            break;
+        }
+        batch.offsets[count++] = offset;
+        offset += size;
+    }
+    batch.resize(count);
+
+    // Fields are independent per instruction, the scalar loop picks up what the vector loop left
+    for (auto i = DecodeFields(words, batch); i < count; i++) {
+        auto word = words[batch.offsets[i]];
+        batch.opcodes[i] = static_cast<uint16_t>(word);
+        batch.operand_types[0][i] = static_cast<uint8_t>(word >> 16u);
+        batch.operand_types[1][i] = static_cast<uint8_t>(word >> 24u);
+        batch.result_types[i] = static_cast<uint8_t>(word >> 32u);
+        batch.operand_meta_data[0][i] = static_cast<uint8_t>(word >> 40u);
+        batch.operand_meta_data[1][i] = static_cast<uint8_t>(word >> 48u);
+        batch.result_locations[i] = static_cast<uint8_t>(word >> 56u);
+    }
+    return offset;
+}
+
 std::deque<hestia::MemoryRequest> FunctionalProcessorLibrary::GatherOperands(Instruction &instruction) {
+    auto& context = m_contexts[instruction.context];
     ++m_counters.instructions.decoded;
-    ++m_program_counter;
+    ++context.program_counter;
+    // Extensions are only consumed here so a stalled instruction can be decoded again
+    if (instruction.opcode != Opcode::EXTEND) {
+        context.extended = 0;
+    }
     std::deque<hestia::MemoryRequest> requests;
     for (auto &op : instruction.operands) {
         ++m_counters.operands.gathered;
         switch (op.type) {
             case Operand::Type::REGISTER:
                 ++m_counters.operands.registers;
-                op.value = m_registers[op.location];
+                op.value = context.registers[op.location];
                 op.status = Operand::Status::GATHERED;
                 break;
             case Operand::Type::CONSTANT: {
                 ++m_counters.operands.constants;
                 op.status = Operand::Status::REQUESTED;
                 hestia::MemoryRequest request{};
-                request.address = m_program_counter;
+                request.address = context.program_counter;
                 request.size = 0;
                 requests.emplace_back(request);
-                ++m_program_counter;
+                ++context.program_counter;
                 break;
             }
             case Operand::Type::INDIRECT_MEMORY_REGISTER: {
                 ++m_counters.operands.indirect_memories;
                 op.status = Operand::Status::REQUESTED;
                 hestia::MemoryRequest request{};
-                request.address = m_registers[op.location];
-                request.size = 1;
+                request.address = context.registers[op.location];
+                request.size = GetOperandSize(instruction.opcode);
                 requests.emplace_back(request);
                 break;
             }
             case Operand::Type::EMBEDDED:
                 ++m_counters.operands.embedded;
                 break;
+            case Operand::Type::VECTOR_REGISTER: {
+                ++m_counters.operands.vector_registers;
+                auto elements = context.vector_registers.begin() + op.location * m_vector_length;
+                op.values.assign(elements, elements + m_vector_length);
+                op.status = Operand::Status::GATHERED;
+                break;
+            }
         }
     }
+    // Count the result type before an indirect destination is resolved to memory
+    m_counters.mix.Gather(instruction);
+    // Resolve an indirect destination now so the rest of the pipeline only ever sees a memory address
+    if (instruction.result.type == Result::Type::INDIRECT_MEMORY_REGISTER) {
+        instruction.result.type = Result::Type::MEMORY;
+        instruction.result.location = context.registers[instruction.result.location];
+    }
     return requests;
 }
 
@@ -117,6 +270,11 @@ void FunctionalProcessorLibrary::ProcessOperandMemoryResponses(Instruction &inst
         for (auto& op : instruction.operands) {
             if (op.status == Operand::Status::REQUESTED) {
                 op.value = response.data[0];
+                // Vector opcodes read a whole vector through their indirect operands
+                if (op.type == Operand::Type::INDIRECT_MEMORY_REGISTER &&
+                    GetDetails(instruction.opcode).type == OpcodeDetails::Type::VECTOR) {
+                    op.values.assign(response.data.begin(), response.data.end());
+                }
                 op.status = Operand::Status::GATHERED;
                 break;
             }
@@ -124,35 +282,6 @@ void FunctionalProcessorLibrary::ProcessOperandMemoryResponses(Instruction &inst
     }
 }
 
-std::string to_string(Opcode op) {
-    switch (op){
-        case Opcode::MOVE:
-            return "MOVE";
-        case Opcode::ADD:
-            return "ADD";
-        case Opcode::SUBTRACT:
-            return "SUBTRACT";
-        case Opcode::MULTIPLY:
-            return "MULTIPLY";
-        case Opcode::DIVIDE:
-            return "DIVIDE";
-        case Opcode::INCREMENT:
-            return "INCREMENT";
-        case Opcode::DECREMENT:
-            return "DECREMENT";
-        case Opcode::COMPARE:
-            return "COMPARE";
-        case Opcode::JUMP:
-            return "JUMP";
-        case Opcode::JUMP_LESS:
-            return "JUMP_LESS";
-        case Opcode::RETURN:
-            return "RETURN";
-        case Opcode::ENDPRGM:
-            return "ENDPRGM";
-    }
-}
-
 std::string to_string(const std::vector<Operand>& operands) {
     std::string result;
     for (auto const& operand: operands) {
@@ -170,6 +299,9 @@ std::string to_string(const std::vector<Operand>& operands) {
             case Operand::Type::EMBEDDED:
                 result += " E ";
                 break;
+            case Operand::Type::VECTOR_REGISTER:
+                result += " V ";
+                break;
         }
         result += std::to_string(operand.location) + " | ";
     }
@@ -190,6 +322,12 @@ std::string to_string(const Result& result) {
         case Result::Type::MEMORY:
             string += " M ";
             break;
+        case Result::Type::INDIRECT_MEMORY_REGISTER:
+            string += " I ";
+            break;
+        case Result::Type::VECTOR_REGISTER:
+            string += " V ";
+            break;
         case Result::Type::NONE:
             string += " N/A ";
             break;
@@ -207,6 +345,13 @@ std::string to_string(const Flags& flags) {
     return string;
 }
 
+/**
+ * Pack flags into the low 4 bits of a byte for event records (sign, zero, parity, carry)
+ */
+static uint8_t Pack(const Flags& flags) {
+    return flags.sign << 3u | flags.zero << 2u | flags.parity << 1u | flags.carry;
+}
+
 std::string to_string(Instruction& instruction, Flags& before_flags) {
     std::string result;
     result += to_string(instruction.opcode) + " | ";
@@ -219,39 +364,61 @@ std::string to_string(Instruction& instruction, Flags& before_flags) {
 
 void FunctionalProcessorLibrary::Execute(Instruction &instruction) {
     ++m_counters.instructions.executed;
+    m_counters.mix.Execute(instruction);
+    auto& context = m_contexts[instruction.context];
     std::vector<hestia::MemoryRequest> results{};
-    auto flags = m_flags;
+    auto flags = context.flags;
     switch(GetDetails(instruction.opcode).type) {
         case OpcodeDetails::Type::MEMORY:
             ExecuteMemory(instruction);
             break;
         case OpcodeDetails::Type::ALU:
             ExecuteAlu(instruction);
-            m_flags = instruction.result.flags;
+            context.flags = instruction.result.flags;
             break;
         case OpcodeDetails::Type::BRANCH:
             ExecuteControl(instruction);
             break;
+        case OpcodeDetails::Type::VECTOR:
+            ExecuteVector(instruction);
+            break;
     }
-    m_instruction_trace.LogLn(hestia::LoggingType::DEBUG, to_string(instruction, flags).c_str());
+    LOG_EVENT(m_events, EventLevel::DEBUG, FunctionalEvent::EXECUTED, CurrentCycle(m_init),
+              static_cast<uint64_t>(instruction.opcode) |
+              static_cast<uint64_t>(instruction.result.type) << 16u |
+              static_cast<uint64_t>(Pack(flags)) << 24u |
+              static_cast<uint64_t>(Pack(instruction.result.flags)) << 28u,
+              instruction.operands.size() > 0 ? instruction.operands[0].value : 0,
+              instruction.operands.size() > 1 ? instruction.operands[1].value : 0,
+              instruction.result.value);
 
 }
 
 std::deque<hestia::MemoryRequest> FunctionalProcessorLibrary::WriteBack(Instruction &instruction) {
     ++m_counters.instructions.written_back;
+    auto& context = m_contexts[instruction.context];
     std::deque<hestia::MemoryRequest> requests{};
     switch(instruction.result.type) {
         case Result::Type::REGISTER:
-            m_registers[instruction.result.location] = instruction.result.value;
+            context.registers[instruction.result.location] = instruction.result.value;
+            break;
+        case Result::Type::VECTOR_REGISTER:
+            std::copy(instruction.result.values.begin(), instruction.result.values.end(),
+                      context.vector_registers.begin() + instruction.result.location * m_vector_length);
             break;
         case Result::Type::MEMORY: {
             hestia::MemoryRequest request{};
             request.type = hestia::MemoryRequest::Type::WRITE;
             request.address = instruction.result.location;
-            request.data.emplace_back(instruction.result.value);
-            request.size = 1;
+            if (instruction.result.values.empty()) {
+                request.data.emplace_back(instruction.result.value);
+            } else {
+                request.data.assign(instruction.result.values.begin(), instruction.result.values.end());
+            }
+            request.size = request.data.size();
             requests.emplace_back(request);
         }
+        case Result::Type::INDIRECT_MEMORY_REGISTER: // Resolved to MEMORY by GatherOperands
         case Result::Type::NONE:
             break;
     }
@@ -288,9 +455,18 @@ void FunctionalProcessorLibrary::ExecuteAlu(Instruction &instruction) {
             result.flags.carry = MultiplicationOverflow(operands[0].value, operands[1].value);
             break;
         case Opcode::DIVIDE:
-            assert(operands[1].value != 0);
-            result.value = operands[0].value / operands[1].value;
-            result.flags.carry = false;
+            // Division by zero gives 0 and overflowing the quotient wraps, both set the carry flag
+            if (operands[1].value == 0) {
+                ++m_counters.errors.divide_by_zero;
+                result.value = 0;
+                result.flags.carry = true;
+            } else if (operands[1].value == -1) {
+                result.value = static_cast<int64_t>(0 - static_cast<uint64_t>(operands[0].value));
+                result.flags.carry = operands[0].value == std::numeric_limits<int64_t>::min();
+            } else {
+                result.value = operands[0].value / operands[1].value;
+                result.flags.carry = false;
+            }
             break;
         case Opcode::INCREMENT:
             result.value = operands[0].value + 1;
@@ -323,17 +499,134 @@ void FunctionalProcessorLibrary::ExecuteAlu(Instruction &instruction) {
 }
 
 void FunctionalProcessorLibrary::ExecuteControl(Instruction &instruction) {
+    auto& context = m_contexts[instruction.context];
     switch(instruction.opcode) {
         case Opcode::JUMP:
+            ++m_counters.mix.taken;
+            context.program_counter = instruction.operands[0].value;
             break;
         case Opcode::JUMP_LESS:
-            if(m_flags.carry) {
-                m_program_counter = instruction.operands[0].value;
+            if(context.flags.carry) {
+                ++m_counters.mix.taken;
+                context.program_counter = instruction.operands[0].value;
+            } else {
+                ++m_counters.mix.not_taken;
             }
             break;
+        case Opcode::CALL:
+            ++m_counters.mix.taken;
+            context.call_stack.emplace_back(context.program_counter);
+            context.program_counter = instruction.operands[0].value;
+            break;
+        case Opcode::RETURN:
+            // Returning from the outermost frame has nowhere to go, carry on with the next instruction
+            if (context.call_stack.empty()) {
+                ++m_counters.errors.empty_call_stack;
+                break;
+            }
+            ++m_counters.mix.taken;
+            context.program_counter = context.call_stack.back();
+            context.call_stack.pop_back();
+            break;
+        case Opcode::EXTEND: {
+            auto field = instruction.operands[0].value;
+            assert(field >= 0 && field <= EXTEND_RESULT);
+            context.extensions[field] = instruction.operands[1].value;
+            context.extended |= static_cast<uint8_t>(1u << field);
+            break;
+        }
         case Opcode::ENDPRGM:
             ++m_counters.applications.terminated;
-            m_program_counter = 0;
+            LOG_EVENT(m_events, EventLevel::INFO, FunctionalEvent::APPLICATION_TERMINATED, CurrentCycle(m_init));
+            context.program_counter = 0;
+            context.call_stack.clear();
+            context.extended = 0;
+            break;
+        default:
+            assert(false);
+            break;
+    }
+}
+
+/**
+ * Element wise kernels for the vector opcodes. Elements wrap on overflow like the hardware would, the
+ * AVX2 paths handle four elements at a time and the scalar loops whatever is left.
+ */
+static void VectorAdd(const int64_t* a, const int64_t* b, int64_t* out, size_t size) {
+    size_t i = 0;
+#ifdef __AVX2__
+    for (; i + 4 <= size; i += 4) {
+        auto x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+        auto y = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), _mm256_add_epi64(x, y));
+    }
+#endif
+    for (; i < size; i++) {
+        out[i] = static_cast<int64_t>(static_cast<uint64_t>(a[i]) + static_cast<uint64_t>(b[i]));
+    }
+}
+
+static void VectorMultiply(const int64_t* a, const int64_t* b, int64_t* out, size_t size) {
+    size_t i = 0;
+#ifdef __AVX2__
+    // No 64 bit multiply in AVX2, build the low 64 bits from 32 bit halves: lo * lo + (hi * lo + lo * hi) << 32
+    for (; i + 4 <= size; i += 4) {
+        auto x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+        auto y = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i));
+        auto low = _mm256_mul_epu32(x, y);
+        auto cross = _mm256_add_epi64(_mm256_mul_epu32(_mm256_srli_epi64(x, 32), y),
+                                      _mm256_mul_epu32(x, _mm256_srli_epi64(y, 32)));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), _mm256_add_epi64(low, _mm256_slli_epi64(cross, 32)));
+    }
+#endif
+    for (; i < size; i++) {
+        out[i] = static_cast<int64_t>(static_cast<uint64_t>(a[i]) * static_cast<uint64_t>(b[i]));
+    }
+}
+
+static int64_t VectorSum(const int64_t* a, size_t size) {
+    uint64_t sum = 0;
+    size_t i = 0;
+#ifdef __AVX2__
+    auto sums = _mm256_setzero_si256();
+    for (; i + 4 <= size; i += 4) {
+        sums = _mm256_add_epi64(sums, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i)));
+    }
+    alignas(32) uint64_t lanes[4];
+    _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), sums);
+    sum = lanes[0] + lanes[1] + lanes[2] + lanes[3];
+#endif
+    for (; i < size; i++) {
+        sum += static_cast<uint64_t>(a[i]);
+    }
+    return static_cast<int64_t>(sum);
+}
+
+void FunctionalProcessorLibrary::ExecuteVector(Instruction &instruction) {
+    auto &operands = instruction.operands;
+    auto &result = instruction.result;
+    assert(m_vector_length != 0);
+    // Scalar operands are broadcast to every element
+    for (auto& op : operands) {
+        if (op.values.empty()) {
+            op.values.assign(m_vector_length, op.value);
+        }
+    }
+    switch (instruction.opcode) {
+        case Opcode::VLOAD:
+        case Opcode::VSTORE:
+            result.values = operands[0].values;
+            break;
+        case Opcode::VADD:
+            result.values.resize(m_vector_length);
+            VectorAdd(operands[0].values.data(), operands[1].values.data(), result.values.data(), m_vector_length);
+            break;
+        case Opcode::VMUL:
+            result.values.resize(m_vector_length);
+            VectorMultiply(operands[0].values.data(), operands[1].values.data(), result.values.data(), m_vector_length);
+            break;
+        case Opcode::VREDUCE:
+            result.value = VectorSum(operands[0].values.data(), m_vector_length);
             break;
         default:
             assert(false);
@@ -341,6 +634,14 @@ void FunctionalProcessorLibrary::ExecuteControl(Instruction &instruction) {
     }
 }
 
+uint64_t FunctionalProcessorLibrary::GetOperandSize(Opcode opcode) const {
+    return GetDetails(opcode).type == OpcodeDetails::Type::VECTOR ? m_vector_length : 1;
+}
+
+uint64_t FunctionalProcessorLibrary::GetResultSize(Opcode opcode) const {
+    return opcode != Opcode::VREDUCE && GetDetails(opcode).type == OpcodeDetails::Type::VECTOR ? m_vector_length : 1;
+}
+
 bool FunctionalProcessorLibrary::AdditionOverflow(int64_t a, int64_t b) {
     // Positive Overflow
     if (a > 0 && b > 0 && a + b < 0) {
@@ -372,27 +673,75 @@ bool FunctionalProcessorLibrary::MultiplicationOverflow(int64_t a, int64_t b) {
 }
 
 std::vector<uint64_t> FunctionalProcessorLibrary::Encode(const Instruction &instruction) {
-    std::bitset<64> encoded_instruction = static_cast<uint16_t>(instruction.opcode);;
-    auto operand_types = EncodeOperandTypes(instruction);
-    auto operand_meta_data = EncodeOperandMetaData(instruction);
+    std::vector<uint64_t> encoded_values(EncodedSize(instruction));
+    Encode(instruction, encoded_values.data());
+    return encoded_values;
+}
 
-    for (size_t i = 0; i < operand_types.size(); i++) {
-        encoded_instruction[16 + i] = operand_types[i];
+uint64_t* FunctionalProcessorLibrary::Encode(const Instruction &instruction, uint64_t* out) {
+    // Fields too wide for their metadata byte go in prefixes, the byte itself is then ignored
+    for (size_t i = 0; i < instruction.operands.size(); i++) {
+        auto const& op = instruction.operands[i];
+        if (IsWide(op)) {
+            out = EncodeExtend(i, op.type == Operand::Type::EMBEDDED ? op.value : op.location, out);
+        }
     }
-
-    for (size_t i = 0; i < operand_types.size(); i++) {
-        encoded_instruction[16 + operand_types.size() + i] = operand_meta_data[i];
+    if (IsWide(instruction.result)) {
+        out = EncodeExtend(EXTEND_RESULT, instruction.result.location, out);
     }
 
-    std::vector<uint64_t> encoded_values;
-    encoded_values.emplace_back(encoded_instruction.to_ulong());
+    auto operand_types = EncodeOperandTypes(instruction);
+    auto operand_meta_data = EncodeOperandMetaData(instruction);
+
+    *out++ = static_cast<uint64_t>(instruction.opcode) |
+             operand_types.to_ullong() << 16u |
+             operand_meta_data.to_ullong() << (16u + operand_types.size());
 
     for (auto const& op : instruction.operands) {
         if (op.type == Operand::Type::CONSTANT) {
-            encoded_values.emplace_back(op.value);
+            *out++ = op.value;
         }
     }
-    return encoded_values;
+    return out;
+}
+
+uint8_t FunctionalProcessorLibrary::EncodedSize(const Instruction &instruction) {
+    uint8_t size = 1;
+    for (auto const& op : instruction.operands) {
+        size += op.type == Operand::Type::CONSTANT;
+        size += IsWide(op) ? EXTEND_SIZE : 0;
+    }
+    size += IsWide(instruction.result) ? EXTEND_SIZE : 0;
+    return size;
+}
+
+uint64_t* FunctionalProcessorLibrary::EncodeExtend(uint8_t field, uint64_t value, uint64_t* out) {
+    Instruction extend{};
+    extend.opcode = Opcode::EXTEND;
+    extend.operands.resize(2);
+    extend.operands[0].type = Operand::Type::EMBEDDED;
+    extend.operands[0].value = field;
+    extend.operands[1].type = Operand::Type::CONSTANT;
+    extend.operands[1].value = static_cast<int64_t>(value);
+    return Encode(extend, out);
+}
+
+bool FunctionalProcessorLibrary::IsWide(const Operand &operand) {
+    switch (operand.type) {
+        case Operand::Type::REGISTER:
+        case Operand::Type::INDIRECT_MEMORY_REGISTER:
+        case Operand::Type::VECTOR_REGISTER:
+            return operand.location > 0xFFu;
+        case Operand::Type::EMBEDDED:
+            return operand.value < 0 || operand.value > 0xFF;
+        case Operand::Type::CONSTANT:
+            break;
+    }
+    return false;
+}
+
+bool FunctionalProcessorLibrary::IsWide(const Result &result) {
+    return result.type != Result::Type::NONE && result.location > 0xFFu;
 }
 
 auto FunctionalProcessorLibrary::EncodeOperandTypes(const Instruction &instruction) -> OperandEncodedType {
@@ -413,6 +762,9 @@ auto FunctionalProcessorLibrary::EncodeOperandTypes(const Instruction &instructi
                 result[pos].flip();
                 result[pos + 1].flip();
                 break;
+            case Operand::Type::VECTOR_REGISTER:
+                result[pos + 2].flip();
+                break;
         }
     }
     switch (instruction.result.type) {
@@ -424,6 +776,13 @@ auto FunctionalProcessorLibrary::EncodeOperandTypes(const Instruction &instructi
         case Result::Type::MEMORY:
             result[17].flip();
             break;
+        case Result::Type::INDIRECT_MEMORY_REGISTER:
+            result[16].flip();
+            result[17].flip();
+            break;
+        case Result::Type::VECTOR_REGISTER:
+            result[18].flip();
+            break;
     }
     return result;}
 
@@ -444,6 +803,9 @@ auto FunctionalProcessorLibrary::EncodeOperandMetaData(const Instruction &instru
             case Operand::Type::EMBEDDED:
                 result |= (static_cast<uint64_t>(instruction.operands[i].value) & 0xFFu) << pos;
                 break;
+            case Operand::Type::VECTOR_REGISTER:
+                result |= (instruction.operands[i].location & 0xFFu) << pos;
+                break;
         }
     }
     if(instruction.result.type != Result::Type::NONE) {
@@ -455,18 +817,82 @@ auto FunctionalProcessorLibrary::EncodeOperandMetaData(const Instruction &instru
 FunctionalProcessorLibrary::Counters::Counters(const std::string &name, hestia::Manageable* owner,  const hestia::Init &init) :
         instructions("instructions.", owner, init),
         operands("operands.", owner, init),
-        applications("applications.", owner, init) {}
+        applications("applications.", owner, init),
+        errors("errors.", owner, init),
+        mix("mix.", owner, init) {}
+
+FunctionalProcessorLibrary::Counters::Mix::Mix(const std::string &name, hestia::Manageable *owner, const hestia::Init &init) :
+        taken(name + "branches.taken", owner, init),
+        not_taken(name + "branches.not_taken", owner, init) {
+    indices.fill(NO_MIX_INDEX);
+    for (auto const& detail : GetDetails()) {
+        indices[static_cast<uint8_t>(detail.first)] = static_cast<uint8_t>(opcodes.size());
+        opcodes.emplace_back(name + to_string(detail.first) + ".", owner, init);
+    }
+}
+
+FunctionalProcessorLibrary::Counters::Mix::OpcodeCounters::OpcodeCounters(const std::string &name, hestia::Manageable *owner, const hestia::Init &init) :
+        executed(name + "executed", owner, init) {
+    for (auto const& type : OPERAND_TYPE_NAMES) {
+        operands.emplace_back(name + "operands." + type, owner, init);
+    }
+    for (auto const& type : RESULT_TYPE_NAMES) {
+        results.emplace_back(name + "results." + type, owner, init);
+    }
+}
+
+void FunctionalProcessorLibrary::Counters::Mix::Gather(const ::Instruction &instruction) {
+    auto index = indices[static_cast<uint8_t>(instruction.opcode)];
+    if (index == NO_MIX_INDEX) {
+        return;
+    }
+    ++opcodes[index].results[static_cast<uint8_t>(instruction.result.type)];
+}
+
+void FunctionalProcessorLibrary::Counters::Mix::Execute(const ::Instruction &instruction) {
+    auto index = indices[static_cast<uint8_t>(instruction.opcode)];
+    if (index == NO_MIX_INDEX) {
+        return;
+    }
+    auto& counters = opcodes[index];
+    ++counters.executed;
+    for (auto const& operand : instruction.operands) {
+        ++counters.operands[static_cast<uint8_t>(operand.type)];
+    }
+}
+
+std::vector<std::string> FunctionalProcessorLibrary::MixCounterNames() {
+    std::vector<std::string> names;
+    for (auto const& detail : GetDetails()) {
+        auto name = "mix." + to_string(detail.first) + ".";
+        names.emplace_back(name + "executed");
+        for (auto const& type : OPERAND_TYPE_NAMES) {
+            names.emplace_back(name + "operands." + type);
+        }
+        for (auto const& type : RESULT_TYPE_NAMES) {
+            names.emplace_back(name + "results." + type);
+        }
+    }
+    names.emplace_back("mix.branches.taken");
+    names.emplace_back("mix.branches.not_taken");
+    return names;
+}
 
 FunctionalProcessorLibrary::Counters::Application::Application(const std::string &name, hestia::Manageable* owner, const hestia::Init &init) :
         started(name + "started", owner, init),
         terminated(name + "terminated", owner, init) {}
 
+FunctionalProcessorLibrary::Counters::Error::Error(const std::string &name, hestia::Manageable* owner, const hestia::Init &init) :
+        divide_by_zero(name + "divide_by_zero", owner, init),
+        empty_call_stack(name + "empty_call_stack", owner, init) {}
+
 FunctionalProcessorLibrary::Counters::Operand::Operand(const std::string &name, hestia::Manageable *owner, const hestia::Init &init) :
         gathered(name + "gathered", owner, init),
         registers(name + "registers", owner, init),
         constants(name + "constants", owner, init),
         indirect_memories(name + "indirect_memories", owner, init),
-        embedded(name + "embedded", owner, init){}
+        embedded(name + "embedded", owner, init),
+        vector_registers(name + "vector_registers", owner, init) {}
 
 FunctionalProcessorLibrary::Counters::Instruction::Instruction(const std::string &name, hestia::Manageable *owner, const hestia::Init &init) :
         fetched(name + "fetched", owner, init),
@@ -0,0 +1,43 @@
+
+#include "transactions/instruction_batch.h"
+
+void InstructionBatch::clear() noexcept {
+    resize(0);
+}
+
+void InstructionBatch::resize(size_t size) {
+    offsets.resize(size);
+    opcodes.resize(size);
+    for (size_t i = 0; i < MAX_OPERANDS; i++) {
+        operand_types[i].resize(size);
+        operand_meta_data[i].resize(size);
+    }
+    result_types.resize(size);
+    result_locations.resize(size);
+}
+
+Instruction InstructionBatch::Get(size_t index) const {
+    Instruction result{};
+    result.opcode = static_cast<Opcode>(opcodes[index]);
+    result.operands.resize(GetDetails(result.opcode).num_operands);
+    for (size_t i = 0; i < result.operands.size(); i++) {
+        auto& operand = result.operands[i];
+        operand.type = static_cast<Operand::Type>(operand_types[i][index]);
+        switch (operand.type) {
+            case Operand::Type::REGISTER:
+            case Operand::Type::INDIRECT_MEMORY_REGISTER:
+            case Operand::Type::VECTOR_REGISTER:
+                operand.location = operand_meta_data[i][index];
+                break;
+            case Operand::Type::CONSTANT:
+                break;
+            case Operand::Type::EMBEDDED:
+                operand.value = operand_meta_data[i][index];
+                operand.status = Operand::Status::GATHERED;
+                break;
+        }
+    }
+    result.result.type = static_cast<Result::Type>(result_types[index] & 0x7u);
+    result.result.location = result_locations[index];
+    return result;
+}
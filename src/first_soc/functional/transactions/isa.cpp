@@ -3,49 +3,110 @@
 
 #include <cassert>
 
-std::unordered_map<Opcode, OpcodeDetails> details;
+using DetailsMap = std::unordered_map<Opcode, OpcodeDetails>;
 
-void SetupDetails();
+static DetailsMap SetupDetails();
 
 const std::unordered_map<Opcode, OpcodeDetails>& GetDetails() {
-    if (details.empty()) {
-       SetupDetails();
-    }
+    // Built once by the first caller, C++11 makes that thread safe when partitions first decode on worker threads
+    static const DetailsMap details = SetupDetails();
     return details;
 }
 
 const OpcodeDetails& GetDetails(Opcode op) {
-    if (details.empty()) {
-        SetupDetails();
-    }
-    assert(details.find(op) != details.end());
-    return details[op];
+    auto const& details = GetDetails();
+    auto found = details.find(op);
+    assert(found != details.end());
+    return found->second;
 }
 
-void SetupMemoryDetails();
-void SetupALUDetails();
-void SetupControlDetails();
+static void SetupMemoryDetails(DetailsMap& details);
+static void SetupALUDetails(DetailsMap& details);
+static void SetupControlDetails(DetailsMap& details);
+static void SetupVectorDetails(DetailsMap& details);
 
 
-void SetupDetails() {
-    SetupMemoryDetails();
-    SetupALUDetails();
-    SetupControlDetails();
+static DetailsMap SetupDetails() {
+    DetailsMap details;
+    SetupMemoryDetails(details);
+    SetupALUDetails(details);
+    SetupControlDetails(details);
+    SetupVectorDetails(details);
+    return details;
 }
 
 
-void SetupMemoryDetails() {
+static void SetupMemoryDetails(DetailsMap& details) {
     details[Opcode::MOVE] = {OpcodeDetails::Type::MEMORY, 1};
 }
 
-void SetupALUDetails() {
+static void SetupALUDetails(DetailsMap& details) {
     details[Opcode::ADD] = {OpcodeDetails::Type::ALU, 2};
+    details[Opcode::SUBTRACT] = {OpcodeDetails::Type::ALU, 2};
+    details[Opcode::MULTIPLY] = {OpcodeDetails::Type::ALU, 2};
+    details[Opcode::DIVIDE] = {OpcodeDetails::Type::ALU, 2};
     details[Opcode::INCREMENT] = {OpcodeDetails::Type::ALU, 1};
+    details[Opcode::DECREMENT] = {OpcodeDetails::Type::ALU, 1};
     details[Opcode::COMPARE] = {OpcodeDetails::Type::ALU, 2};
 }
 
-void SetupControlDetails() {
+static void SetupControlDetails(DetailsMap& details) {
     details[Opcode::ENDPRGM] = {OpcodeDetails::Type::BRANCH, 0};
+    details[Opcode::JUMP] = {OpcodeDetails::Type::BRANCH, 1};
     details[Opcode::JUMP_LESS] = {OpcodeDetails::Type::BRANCH, 1};
+    details[Opcode::CALL] = {OpcodeDetails::Type::BRANCH, 1};
+    details[Opcode::RETURN] = {OpcodeDetails::Type::BRANCH, 0};
+    // Serializes like a branch so the next instruction is only decoded once the prefix has executed
+    details[Opcode::EXTEND] = {OpcodeDetails::Type::BRANCH, 2};
 }
 
+static void SetupVectorDetails(DetailsMap& details) {
+    details[Opcode::VLOAD] = {OpcodeDetails::Type::VECTOR, 1};
+    details[Opcode::VSTORE] = {OpcodeDetails::Type::VECTOR, 1};
+    details[Opcode::VADD] = {OpcodeDetails::Type::VECTOR, 2};
+    details[Opcode::VMUL] = {OpcodeDetails::Type::VECTOR, 2};
+    details[Opcode::VREDUCE] = {OpcodeDetails::Type::VECTOR, 1};
+}
+
+std::string to_string(Opcode op) {
+    switch (op){
+        case Opcode::MOVE:
+            return "MOVE";
+        case Opcode::ADD:
+            return "ADD";
+        case Opcode::SUBTRACT:
+            return "SUBTRACT";
+        case Opcode::MULTIPLY:
+            return "MULTIPLY";
+        case Opcode::DIVIDE:
+            return "DIVIDE";
+        case Opcode::INCREMENT:
+            return "INCREMENT";
+        case Opcode::DECREMENT:
+            return "DECREMENT";
+        case Opcode::COMPARE:
+            return "COMPARE";
+        case Opcode::JUMP:
+            return "JUMP";
+        case Opcode::JUMP_LESS:
+            return "JUMP_LESS";
+        case Opcode::RETURN:
+            return "RETURN";
+        case Opcode::CALL:
+            return "CALL";
+        case Opcode::VLOAD:
+            return "VLOAD";
+        case Opcode::VSTORE:
+            return "VSTORE";
+        case Opcode::VADD:
+            return "VADD";
+        case Opcode::VMUL:
+            return "VMUL";
+        case Opcode::VREDUCE:
+            return "VREDUCE";
+        case Opcode::EXTEND:
+            return "EXTEND";
+        case Opcode::ENDPRGM:
+            return "ENDPRGM";
+    }
+}
@@ -0,0 +1,249 @@
+#include <functional/functional_processor_library.h>
+#include <functional/transactions/instruction.h>
+
+#include <hestia/component/component_base.h>
+#include <hestia/testbench/cpp_test_bench.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cinttypes>
+#include <cstdio>
+#include <limits>
+#include <string>
+#include <vector>
+
+/**
+ * Times the hot FunctionalProcessorLibrary functions in isolation. The library needs a hestia
+ * environment to be constructed, so the measurements run inside a component's Setup. Every case
+ * runs the call "iterations" times, REPETITIONS times over, and keeps the fastest repetition.
+ */
+class FunctionalBenchmark : public hestia::ComponentBase {
+public:
+    explicit FunctionalBenchmark(const hestia::ComponentInit &init) :
+            Manageable(hestia::FrameworkType::COMPONENT, init.name),
+            hestia::ComponentBase(init),
+            m_functional_library(init.name + ".functional", m_init),
+            m_iterations(GetUintParam("iterations")),
+            m_output_file(GetParam("output_file")) {}
+
+    void Setup() noexcept override;
+
+    [[nodiscard]] bool Validate() const noexcept override { return m_iterations != 0 && !m_output_file.empty(); }
+
+private:
+
+    static constexpr size_t REPETITIONS = 5;
+    static constexpr uint64_t FIRST_REGISTER = 1;
+    static constexpr uint64_t RESULT_LOCATION = 2;
+
+    struct Measurement {
+        std::string function;
+        std::string name;
+        double ns_per_call;
+    };
+
+    /**
+     * Build an instruction with every operand of one type, values are chosen to be valid for every opcode
+     */
+    static Instruction MakeInstruction(Opcode opcode, Operand::Type operand_type, Result::Type result_type);
+
+    template<typename Prepare, typename Call>
+    void Measure(const std::string& function, const std::string& name, Prepare prepare, Call call);
+
+    template<typename Call>
+    void Measure(const std::string& function, const std::string& name, Call call) {
+        Measure(function, name, []() {}, call);
+    }
+
+    bool Write() const;
+
+    FunctionalProcessorLibrary m_functional_library;
+    const uint64_t m_iterations;
+    const std::string m_output_file;
+
+    std::vector<Measurement> m_results;
+    uint64_t m_sink = 0; /*!< Folds in call results so they can not be optimized away >*/
+};
+
+Instruction FunctionalBenchmark::MakeInstruction(Opcode opcode, Operand::Type operand_type, Result::Type result_type) {
+    Instruction instruction{};
+    instruction.opcode = opcode;
+    instruction.operands.resize(GetDetails(opcode).num_operands);
+    for (size_t i = 0; i < instruction.operands.size(); i++) {
+        auto& operand = instruction.operands[i];
+        operand.type = operand_type;
+        operand.location = FIRST_REGISTER + i;
+        operand.value = 7 - static_cast<int64_t>(i) * 4; // Non zero so DIVIDE is valid
+        operand.status = Operand::Status::GATHERED;
+    }
+    instruction.result.type = result_type;
+    instruction.result.location = RESULT_LOCATION;
+    return instruction;
+}
+
+template<typename Prepare, typename Call>
+void FunctionalBenchmark::Measure(const std::string &function, const std::string &name, Prepare prepare, Call call) {
+    auto best = std::numeric_limits<double>::max();
+    for (size_t repetition = 0; repetition < REPETITIONS; repetition++) {
+        prepare();
+        auto start = std::chrono::steady_clock::now();
+        for (uint64_t i = 0; i < m_iterations; i++) {
+            call();
+        }
+        auto end = std::chrono::steady_clock::now();
+        best = std::min(best, std::chrono::duration<double, std::nano>(end - start).count());
+    }
+    m_results.push_back({function, name, best / static_cast<double>(m_iterations)});
+}
+
+void FunctionalBenchmark::Setup() noexcept {
+    const std::vector<std::pair<Operand::Type, std::string>> operand_types = {
+            {Operand::Type::REGISTER, "register"},
+            {Operand::Type::CONSTANT, "constant"},
+            {Operand::Type::INDIRECT_MEMORY_REGISTER, "indirect_memory_register"},
+            {Operand::Type::EMBEDDED, "embedded"},
+            {Operand::Type::VECTOR_REGISTER, "vector_register"}};
+
+    // Encode, Decode and GatherOperands per operand type
+    for (auto const& operand_type : operand_types) {
+        auto instruction = MakeInstruction(Opcode::ADD, operand_type.first, Result::Type::REGISTER);
+        Measure("Encode", operand_type.second, [&]() {
+            m_sink += FunctionalProcessorLibrary::Encode(instruction).size();
+        });
+        uint64_t encoded[FunctionalProcessorLibrary::MAX_ENCODED_SIZE];
+        Measure("EncodeInto", operand_type.second, [&]() {
+            m_sink += FunctionalProcessorLibrary::Encode(instruction, encoded) - encoded;
+        });
+        hestia::MemoryResponse response{};
+        response.data.emplace_back(encoded[0]);
+        Measure("Decode", operand_type.second, [&]() {
+            m_sink += m_functional_library.Decode(response).operands.size();
+        });
+        auto decoded = m_functional_library.Decode(response);
+        Measure("GatherOperands", operand_type.second, [&]() {
+            m_sink += m_functional_library.GatherOperands(decoded).size();
+        });
+    }
+
+    // Execute per opcode, CALL and RETURN are kept balanced so the call stack stays bounded
+    std::vector<Opcode> opcodes;
+    for (auto const& detail : GetDetails()) {
+        opcodes.emplace_back(detail.first);
+    }
+    std::sort(opcodes.begin(), opcodes.end());
+    auto call = MakeInstruction(Opcode::CALL, Operand::Type::REGISTER, Result::Type::NONE);
+    auto ret = MakeInstruction(Opcode::RETURN, Operand::Type::REGISTER, Result::Type::NONE);
+    uint64_t call_depth = 0;
+    auto balance = [&](uint64_t depth) {
+        for (; call_depth > depth; call_depth--) {
+            m_functional_library.Execute(ret);
+        }
+        for (; call_depth < depth; call_depth++) {
+            m_functional_library.Execute(call);
+        }
+    };
+    for (auto const& opcode : opcodes) {
+        auto type = GetDetails(opcode).type;
+        auto result_type = type == OpcodeDetails::Type::BRANCH || opcode == Opcode::COMPARE ?
+                           Result::Type::NONE : Result::Type::REGISTER;
+        auto operand_type = Operand::Type::REGISTER;
+        if (type == OpcodeDetails::Type::VECTOR) {
+            operand_type = Operand::Type::VECTOR_REGISTER;
+            result_type = opcode == Opcode::VREDUCE ? Result::Type::REGISTER : Result::Type::VECTOR_REGISTER;
+        }
+        auto instruction = MakeInstruction(opcode, operand_type, result_type);
+        if (operand_type == Operand::Type::VECTOR_REGISTER) {
+            // Vector operands carry their elements, read them from the vector registers once
+            m_functional_library.GatherOperands(instruction);
+        }
+        if (opcode == Opcode::EXTEND) {
+            instruction.operands[0].value = FunctionalProcessorLibrary::EXTEND_RESULT;
+        }
+        auto prepare = [&]() {
+            // Give RETURN something to pop, and account for what the timed calls will push or pop
+            balance(opcode == Opcode::RETURN ? m_iterations : 0);
+            if (opcode == Opcode::CALL) {
+                call_depth = m_iterations;
+            } else if (opcode == Opcode::RETURN) {
+                call_depth = 0;
+            }
+        };
+        Measure("Execute", to_string(opcode), prepare, [&]() {
+            m_functional_library.Execute(instruction);
+            m_sink += instruction.result.value;
+        });
+    }
+    balance(0);
+
+    // WriteBack per result type, indirect results are resolved to memory before write back
+    const std::vector<std::pair<Result::Type, std::string>> result_types = {
+            {Result::Type::NONE, "none"},
+            {Result::Type::REGISTER, "register"},
+            {Result::Type::MEMORY, "memory"},
+            {Result::Type::VECTOR_REGISTER, "vector_register"}};
+    for (auto const& result_type : result_types) {
+        auto instruction = MakeInstruction(Opcode::ADD, Operand::Type::REGISTER, result_type.first);
+        if (result_type.first == Result::Type::VECTOR_REGISTER) {
+            instruction.opcode = Opcode::VADD;
+            instruction.result.values.assign(m_functional_library.GetVectorLength(), 1);
+        }
+        Measure("WriteBack", result_type.second, [&]() {
+            m_sink += m_functional_library.WriteBack(instruction).size();
+        });
+    }
+
+    if (!Write()) {
+        m_logger.LogLn(hestia::LoggingType::WARNING, ("Failed to write " + m_output_file).c_str());
+    }
+}
+
+bool FunctionalBenchmark::Write() const {
+    auto output = std::fopen(m_output_file.c_str(), "w");
+    if (output == nullptr) {
+        return false;
+    }
+    std::fprintf(output, "{\n  \"benchmark\": \"functional_library\",\n  \"iterations\": %" PRIu64 ",\n"
+                         "  \"repetitions\": %zu,\n  \"results\": [\n", m_iterations, REPETITIONS);
+    for (size_t i = 0; i < m_results.size(); i++) {
+        auto const& result = m_results[i];
+        std::fprintf(output, "    {\"function\": \"%s\", \"case\": \"%s\", \"ns_per_call\": %.3f, \"calls_per_second\": %.0f}%s\n",
+                     result.function.c_str(), result.name.c_str(), result.ns_per_call, 1e9 / result.ns_per_call,
+                     i + 1 == m_results.size() ? "" : ",");
+    }
+    std::fprintf(output, "  ]\n}\n");
+    return std::fclose(output) == 0;
+}
+
+/**
+ * Usage: functional_benchmark [output file] [iterations]
+ */
+int main(int argc, char* argv[]) {
+    const std::string output_file = argc > 1 ? argv[1] : "functional_benchmark.json";
+    const std::string iterations = argc > 2 ? argv[2] : "1000000";
+
+    hestia::CppTestBench test_bench{};
+    test_bench.AddComponentFactories({
+        {"functional_benchmark", hestia::CreateComponent<FunctionalBenchmark>}
+    });
+
+    const std::string benchmark_name = "benchmark";
+    test_bench.SetParameter(hestia::FrameworkType::COMPONENT, benchmark_name, "iterations", iterations);
+    test_bench.SetParameter(hestia::FrameworkType::COMPONENT, benchmark_name, "output_file", output_file);
+    test_bench.SetParameter(hestia::FrameworkType::COMPONENT, benchmark_name + ".functional", "num_registers", "10");
+    test_bench.SetParameter(hestia::FrameworkType::COMPONENT, benchmark_name + ".functional", "num_vector_registers", "4");
+    test_bench.SetParameter(hestia::FrameworkType::COMPONENT, benchmark_name + ".functional", "vector_length", "8");
+    test_bench.SetParameter(hestia::FrameworkType::COMPONENT, benchmark_name + ".functional", "event_log_file", "");
+    test_bench.CreateComponent("functional_benchmark", benchmark_name);
+
+    if(!test_bench.Validate()) {
+        printf("Benchmark failed to validate");
+        exit(1);
+    }
+
+    // All of the measurements run during setup
+    test_bench.Setup();
+    test_bench.TearDown();
+
+    printf("Wrote %s\n", output_file.c_str());
+    return 0;
+}
@@ -1,112 +1,83 @@
-#include "components/memory_bound_processor.h"
-#include "components/functional_processor.h"
-#include "components/performant_processor.h"
-#include "components/pipelined_processor.h"
-#include "applications/simple_application.h"
-#include "applications/loop_application.h"
-#include "observers/doorbell.h"
+#include "processor_test_bench.h"
 
-#include <hestia/toolbox/components/memory.h>
-#include <hestia/testbench/cpp_test_bench.h>
+#include <counter_store/columnar_sampler.h>
 
+#include <cstring>
+
+/**
+ * Runs the loop driver, or a program image with -i, on one of the processor models. The number of
+ * remaining arguments picks the model: none for functional, one for memory bound, two for performant
+ * and three or more for pipelined.
+ * Usage: first_soc [-i <image>] [args...]
+ */
 int main(int argc, char* argv[]) {
     // Instantiate our test bench
-    hestia::CppTestBench test_bench{};
-    test_bench.AddComponentFactories({
-        {"functional_processor", hestia::CreateComponent<FunctionalProcessor>},
-        {"memory_bound_processor", hestia::CreateComponent<MemoryBoundProcessor>},
-        {"performant_processor", hestia::CreateComponent<PerformantProcessor>},
-        {"pipelined_processor", hestia::CreateComponent<PipelinedProcessor>},
-        {"simple_driver", hestia::CreateComponent<SimpleApplication>},
-        {"loop_driver", hestia::CreateComponent<LoopApplication>},
-        {"memory", hestia::CreateComponent<hestia::MemoryComponent>}
-    });
-    test_bench.AddObserverFactories({
-        {"doorbell", hestia::CreateObserver<DoorbellDumper>}
-    });
-
-    bool build_functional = argc == 1;
-    bool build_memory_bound = argc == 2;
-    bool build_performant = argc == 3;
-    bool build_pipelined = argc == 4;
-
-    test_bench.AddDomain("clk", 1);
-    const std::string memory_name = "mem";
-    test_bench.CreateMemory(memory_name, {hestia::MemoryParameters::Type::LINEAR, 1024});
-
-    // Names of our components
-    const std::string processor_name = "processor";
-    const std::string application_name = "simple_application";
-    const std::string memory_component_name = "ram";
-
-    test_bench.SetParameter(hestia::FrameworkType::COMPONENT, application_name, "memory_name", memory_name);
-    test_bench.SetParameter(hestia::FrameworkType::COMPONENT, application_name, "num_ops_per_iteration", "5");
-    test_bench.SetParameter(hestia::FrameworkType::COMPONENT, application_name, "num_iterations", "2");
-    test_bench.SetParameter(hestia::FrameworkType::COMPONENT, application_name, "mode", "memory");
-
-    test_bench.SetParameter(hestia::FrameworkType::COMPONENT, processor_name + ".functional", "num_registers", "10");
-    test_bench.SetParameter(hestia::FrameworkType::COMPONENT, processor_name, "memory_name", memory_name);
-    test_bench.SetParameter(hestia::FrameworkType::COMPONENT, memory_component_name, "memory_name", memory_name);
-
-    hestia::ConnectionParameters connection_parameters{};
-    connection_parameters.is_timed = true;
-    connection_parameters.domain = "clk";
-    connection_parameters.is_observable = true;
-
-    // Create our components
-    if(build_functional) {
-        test_bench.CreateComponent("functional_processor", processor_name);
-    } else {
-        if (build_memory_bound) {
-            test_bench.CreateComponent("memory_bound_processor", processor_name);
+    ProcessorTestBench test_bench{};
+
+    ProcessorTestBench::Config config{};
+    int num_args = 0;
+    for (int i = 1; i < argc; i++) {
+        if (std::strcmp(argv[i], "-i") == 0 && i + 1 < argc) {
+            // Run an image produced by the assembler instead of the loop driver's program
+            config.application = "image_driver";
+            config.image_file = argv[++i];
         } else {
-            test_bench.SetConnectionParameters("processor.fetcher.processor.fetcher", connection_parameters);
-            test_bench.SetConnectionParameters("processor.decoder.processor.decoder", connection_parameters);
-            test_bench.SetConnectionParameters("processor.executor.processor.executor", connection_parameters);
-            test_bench.SetConnectionParameters("processor.write_back.processor.write_back", connection_parameters);
-            if(build_performant) {
-                test_bench.CreateComponent("performant_processor", processor_name);
-            } else {
-                test_bench.CreateComponent("pipelined_processor", processor_name);
-            }
+            ++num_args;
         }
-        test_bench.CreateComponent("memory", memory_component_name);
     }
 
-    test_bench.CreateComponent("loop_driver", application_name);
+    bool build_functional = num_args == 0;
+    bool build_memory_bound = num_args == 1;
+    bool build_performant = num_args == 2;
 
-    test_bench.CreateConnection(application_name, "doorbell", processor_name, "doorbell", connection_parameters);
-    if(!build_functional) {
-        test_bench.CreateConnection(processor_name, "instruction_request", memory_component_name, "requests", connection_parameters);
-        test_bench.CreateConnection(processor_name, "data_request", memory_component_name, "requests", connection_parameters);
-        test_bench.CreateConnection(memory_component_name, "responses", processor_name, "instruction_response", connection_parameters);
-        test_bench.CreateConnection(memory_component_name, "responses", processor_name, "data_response", connection_parameters);
+    if (build_functional) {
+        config.processor = "functional_processor";
+    } else if (build_memory_bound) {
+        config.processor = "memory_bound_processor";
+    } else if (build_performant) {
+        config.processor = "performant_processor";
+    } else {
+        config.processor = "pipelined_processor";
     }
-    const std::string sampler_name = "csv_sampler";
+    config.mode = "memory";
+    config.num_iterations = 2;
+    config.num_ops_per_iteration = 5;
+    // Binary event logs, an empty file name disables them
+    config.event_log_file = "instructions.events";
+    // Set to a file name to get a Chrome / Perfetto timeline of the pipelined processors
+    config.trace_file = "";
+    // Set to a file name to get a per address profile of the pipelined processors, hottest first
+    config.profile_file = "";
+    test_bench.Build(config);
+    const auto& processor_name = test_bench.processor_name;
+
+    std::string counter_prefix;
     if(build_functional) {
-        test_bench.SetParameter(hestia::FrameworkType::SAMPLER, sampler_name, "file", "functional_counters.csv");
+        counter_prefix = "functional";
     } else if (build_memory_bound) {
-        test_bench.SetParameter(hestia::FrameworkType::SAMPLER, sampler_name, "file", "memory_counters.csv");
+        counter_prefix = "memory";
     } else if (build_performant) {
-        test_bench.SetParameter(hestia::FrameworkType::SAMPLER, sampler_name, "file", "performant_counters.csv");
+        counter_prefix = "performant";
     } else {
-        test_bench.SetParameter(hestia::FrameworkType::SAMPLER, sampler_name, "file", "pipelined_counters.csv");
+        counter_prefix = "pipelined";
     }
+    auto counter_file = counter_prefix + "_counters.cstore";
+    auto mix_file = counter_prefix + "_mix.cstore";
 
-    test_bench.SetParameter(hestia::FrameworkType::SAMPLER, sampler_name, "domain", "clk");
-    test_bench.SetParameter(hestia::FrameworkType::SAMPLER, sampler_name, "sample_rate", "5");
-    test_bench.CreateSampler(sampler_name);
-    test_bench.AttachCountersToSampler(sampler_name, ".*instructions.*");
+    // Counters are stored column wise in a binary store, use counter_export to get a csv back
+    counter_store::ColumnarSampler sampler(test_bench, counter_file, 5);
+    for (auto const& counter : {"fetched", "decoded", "executed", "written_back"}) {
+        sampler.AddCounter(processor_name + ".functional.instructions." + counter);
+    }
+    // Dynamic instruction mix, to see which instructions and operand types a run spent its time on.
+    // There are a couple of hundred of them so they are only sampled once at the end of the run.
+    counter_store::ColumnarSampler mix_sampler(test_bench, mix_file, 0);
+    for (auto const& counter : FunctionalProcessorLibrary::MixCounterNames()) {
+        mix_sampler.AddCounter(processor_name + ".functional." + counter);
+    }
 
     test_bench.CreateSink("console_sink");
-    test_bench.AttachLoggerToSink(hestia::FrameworkType::COMPONENT, processor_name + ".functional", "console_sink");
-
-    hestia::SinkParameters instruction_sink_params;
-    instruction_sink_params.type = hestia::SinkType::FILE;
-    instruction_sink_params.file = "instructions.log";
-
-    test_bench.CreateSink("instruction_sink", instruction_sink_params);
-    test_bench.AttachLoggerToSink(hestia::FrameworkType::COMPONENT, processor_name + ".functional.instructions", "instruction_sink");
+    test_bench.AttachLoggerToSink(hestia::FrameworkType::COMPONENT, processor_name, "console_sink");
 
     // Validate the design
     if(!test_bench.Validate()) {
@@ -116,9 +87,26 @@ int main(int argc, char* argv[]) {
 
     // Give everything a chance to setup
     test_bench.Setup();
+    if(!sampler.Open()) {
+        printf("Failed to create counter store %s", counter_file.c_str());
+        exit(1);
+    }
+    if(!mix_sampler.Open()) {
+        printf("Failed to create counter store %s", mix_file.c_str());
+        exit(1);
+    }
 
     // Clock until no longer busy
-    while (test_bench.Clock(1)) {}
+    uint64_t cycle = 0;
+    while (test_bench.Clock(1)) {
+        sampler.Clock(++cycle);
+    }
+    if (!sampler.Close(cycle)) {
+        printf("Failed to write counter store %s", counter_file.c_str());
+    }
+    if (!mix_sampler.Close(cycle)) {
+        printf("Failed to write counter store %s", mix_file.c_str());
+    }
 
     // Tear down the design
     test_bench.TearDown();
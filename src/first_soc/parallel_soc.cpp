@@ -0,0 +1,91 @@
+#include "processor_test_bench.h"
+
+#include <parallel/channel.h>
+#include <parallel/parallel_simulation.h>
+
+#include <chrono>
+#include <cinttypes>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+ * Multi core SoC: every core is a processor with its own memory and loop driver, split in a
+ * processor partition and a memory partition so the whole design spreads over host threads.
+ * Cycle and instruction counts do not depend on the number of threads, only wall time does.
+ *
+ * Usage: parallel_soc [processor] [cores] [threads] [latency]
+ * Defaults to 4 pipelined_processor cores, one thread per host core and a latency of 4 cycles
+ * between a processor and its memory.
+ */
+int main(int argc, char* argv[]) {
+    ProcessorTestBench::Config config{};
+    config.processor = argc > 1 ? argv[1] : "pipelined_processor";
+    config.mode = "split";
+    config.num_iterations = 16;
+    config.num_ops_per_iteration = 1024;
+    config.memory_size = config.num_ops_per_iteration + 64;
+    const uint64_t num_cores = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 4;
+    const size_t num_threads = argc > 3 ? std::strtoull(argv[3], nullptr, 10) : 0;
+    const uint64_t latency = argc > 4 ? std::strtoull(argv[4], nullptr, 10) : 4;
+
+    if (config.processor == "functional_processor") {
+        printf("The functional processor reads memory directly and cannot be partitioned\n");
+        exit(1);
+    }
+    if (num_cores == 0 || latency == 0) {
+        printf("Usage: %s [processor] [cores] [threads] [latency], cores and latency must be at least 1\n", argv[0]);
+        exit(1);
+    }
+
+    // Partitions must not outlive the channels they were built with
+    std::vector<std::unique_ptr<ProcessorTestBench>> processors;
+    std::vector<std::unique_ptr<ProcessorTestBench>> memories;
+    ParallelSimulation simulation(num_threads);
+    for (uint64_t core = 0; core < num_cores; core++) {
+        auto prefix = "core" + std::to_string(core);
+        ProcessorTestBench::CreateChannels(prefix, latency);
+        processors.push_back(std::make_unique<ProcessorTestBench>());
+        processors.back()->BuildProcessorPartition(config, prefix);
+        memories.push_back(std::make_unique<ProcessorTestBench>());
+        memories.back()->BuildMemoryPartition(config, prefix);
+    }
+
+    // Validate and set up serially, setup is where the loop drivers write their programs
+    for (auto const& partitions : {&processors, &memories}) {
+        for (auto& partition : *partitions) {
+            if (!partition->Validate()) {
+                printf("Model failed to validate");
+                exit(1);
+            }
+            partition->Setup();
+            simulation.AddPartition(*partition);
+        }
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    auto cycles = simulation.Run();
+    auto end = std::chrono::steady_clock::now();
+    auto wall_seconds = std::chrono::duration<double>(end - start).count();
+
+    uint64_t instructions = 0;
+    for (uint64_t core = 0; core < num_cores; core++) {
+        auto& processor = *processors[core];
+        auto executed = processor.GetCounterValue(processor.processor_name + ".functional.instructions.executed");
+        printf("core%" PRIu64 ": %" PRIu64 " instructions\n", core, executed);
+        instructions += executed;
+    }
+    printf("%" PRIu64 " cores on %zu threads: %" PRIu64 " cycles in %" PRIu64 " epochs, %" PRIu64 " instructions, %.3f s, %.0f instructions/s\n",
+           num_cores, simulation.GetNumThreads(), cycles, simulation.GetNumEpochs(), instructions, wall_seconds,
+           instructions / wall_seconds);
+
+    for (auto const& partitions : {&processors, &memories}) {
+        for (auto& partition : *partitions) {
+            partition->TearDown();
+        }
+    }
+    ChannelRegistry::Instance().Clear();
+    return 0;
+}
@@ -0,0 +1,450 @@
+#include "program/assembler.h"
+
+#include <functional/functional_processor_library.h>
+
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <cerrno>
+#include <cstdlib>
+
+static const uint64_t MAX_EMBEDDED = 0xFFu;
+static const uint64_t MAX_REGISTER = 0xFFFFu;
+
+static std::string Trim(const std::string& text) {
+    auto begin = text.find_first_not_of(" \t\r");
+    if (begin == std::string::npos) {
+        return "";
+    }
+    auto end = text.find_last_not_of(" \t\r");
+    return text.substr(begin, end - begin + 1);
+}
+
+static std::vector<std::string> Split(const std::string& text, char separator) {
+    std::vector<std::string> parts;
+    size_t begin = 0;
+    while (true) {
+        auto end = text.find(separator, begin);
+        parts.emplace_back(Trim(text.substr(begin, end - begin)));
+        if (end == std::string::npos) {
+            return parts;
+        }
+        begin = end + 1;
+    }
+}
+
+static bool IsIdentifier(const std::string& text) {
+    if (text.empty() || !(std::isalpha(static_cast<unsigned char>(text[0])) || text[0] == '_')) {
+        return false;
+    }
+    return std::all_of(text.begin(), text.end(), [](char c) {
+        return std::isalnum(static_cast<unsigned char>(c)) || c == '_';
+    });
+}
+
+/**
+ * Negative numbers have to fit an int64_t, others a uint64_t whose bits are kept, so full width
+ * words like 0xFFFFFFFFFFFFFFFF can be written. Numbers out of range are rejected rather than clamped.
+ */
+static bool ParseNumber(const std::string& text, int64_t& number) {
+    if (text.empty()) {
+        return false;
+    }
+    char* end = nullptr;
+    errno = 0;
+    if (text[0] == '-') {
+        number = std::strtoll(text.c_str(), &end, 0);
+    } else {
+        number = static_cast<int64_t>(std::strtoull(text.c_str(), &end, 0));
+    }
+    return end != text.c_str() && *end == '\0' && errno != ERANGE;
+}
+
+static bool ParseRegister(const std::string& text, uint64_t& location, char prefix = 'r') {
+    int64_t number = 0;
+    if (text.size() < 2 || std::tolower(static_cast<unsigned char>(text[0])) != prefix ||
+        !std::isdigit(static_cast<unsigned char>(text[1])) || !ParseNumber(text.substr(1), number) ||
+        number < 0 || static_cast<uint64_t>(number) > MAX_REGISTER) {
+        return false;
+    }
+    location = number;
+    return true;
+}
+
+/**
+ * Memory results at labels always take an EXTEND prefix, so relocating them can never overflow the
+ * result byte and the layout is known before labels are resolved
+ */
+static bool IsWideResult(const std::string& label, int64_t number) {
+    return !label.empty() || number < 0 || static_cast<uint64_t>(number) > MAX_EMBEDDED;
+}
+
+static std::unordered_map<std::string, Opcode> SetupMnemonics() {
+    std::unordered_map<std::string, Opcode> mnemonics;
+    for (auto const& detail : GetDetails()) {
+        mnemonics[to_string(detail.first)] = detail.first;
+    }
+    return mnemonics;
+}
+
+static const std::unordered_map<std::string, Opcode>& Mnemonics() {
+    // Built once by the first caller, C++11 makes that thread safe for assemblers on several threads
+    static const std::unordered_map<std::string, Opcode> mnemonics = SetupMnemonics();
+    return mnemonics;
+}
+
+bool Assembler::Assemble(const std::string &source, ProgramImage &image) {
+    m_statements.clear();
+    m_labels.clear();
+    m_entry.clear();
+    m_offset = 0;
+    m_error.clear();
+    image = ProgramImage{};
+
+    // First pass, parse every statement and lay them out
+    size_t line = 0;
+    for (auto const& text : Split(source, '\n')) {
+        if (!ParseLine(++line, text, image)) {
+            return false;
+        }
+    }
+
+    // Second pass, resolve labels and encode
+    image.words.reserve(m_offset);
+    for (auto const& statement : m_statements) {
+        m_line = statement.line;
+        if (statement.is_data) {
+            for (auto const& value : statement.values) {
+                uint64_t word = 0;
+                if (!Resolve(value, word)) {
+                    return false;
+                }
+                if (!value.label.empty()) {
+                    image.relocations.push_back({image.words.size(), ProgramImage::Relocation::Field::WORD});
+                }
+                image.words.emplace_back(word + (value.label.empty() ? 0 : image.load_address));
+            }
+            continue;
+        }
+
+        auto instruction = statement.instruction;
+        // Memory results are resolved first, a prefix for them comes before everything else
+        bool result_prefix = instruction.result.type == Result::Type::MEMORY && IsWideResult(statement.result.label, statement.result.number);
+        if (instruction.result.type == Result::Type::MEMORY) {
+            uint64_t location = 0;
+            if (!Resolve(statement.result, location)) {
+                return false;
+            }
+            if (!statement.result.label.empty()) {
+                location += image.load_address;
+                image.relocations.push_back({statement.offset + 1, ProgramImage::Relocation::Field::WORD});
+            }
+            if (result_prefix) {
+                uint64_t prefix[FunctionalProcessorLibrary::EXTEND_SIZE];
+                FunctionalProcessorLibrary::EncodeExtend(FunctionalProcessorLibrary::EXTEND_RESULT, location, prefix);
+                image.words.insert(image.words.end(), prefix, prefix + FunctionalProcessorLibrary::EXTEND_SIZE);
+                location = 0;
+            }
+            instruction.result.location = location;
+        }
+        // Constants come last
+        auto num_constants = std::count_if(instruction.operands.begin(), instruction.operands.end(),
+                                           [](const Operand& op) { return op.type == Operand::Type::CONSTANT; });
+        uint64_t constant_offset = image.words.size() + FunctionalProcessorLibrary::EncodedSize(instruction) - num_constants;
+        for (size_t i = 0; i < instruction.operands.size(); i++) {
+            auto& operand = instruction.operands[i];
+            auto const& value = statement.values[i];
+            if (operand.type != Operand::Type::CONSTANT) {
+                continue;
+            }
+            uint64_t resolved = 0;
+            if (!Resolve(value, resolved)) {
+                return false;
+            }
+            if (!value.label.empty()) {
+                resolved += image.load_address;
+                image.relocations.push_back({constant_offset, ProgramImage::Relocation::Field::WORD});
+            }
+            operand.value = static_cast<int64_t>(resolved);
+            ++constant_offset;
+        }
+        for (auto const& word : FunctionalProcessorLibrary::Encode(instruction)) {
+            image.words.emplace_back(word);
+        }
+    }
+
+    if (!m_entry.empty()) {
+        auto label = m_labels.find(m_entry);
+        if (label == m_labels.end()) {
+            return Fail("unknown entry label " + m_entry);
+        }
+        image.entry = label->second;
+    }
+    if (image.words.empty()) {
+        return Fail("program is empty");
+    }
+    return true;
+}
+
+bool Assembler::ParseLine(size_t line, std::string text, ProgramImage &image) {
+    m_line = line;
+    text = Trim(text.substr(0, text.find(';')));
+
+    // Labels
+    auto colon = text.find(':');
+    while (colon != std::string::npos && IsIdentifier(Trim(text.substr(0, colon)))) {
+        auto label = Trim(text.substr(0, colon));
+        if (!m_labels.emplace(label, m_offset).second) {
+            return Fail("duplicate label " + label);
+        }
+        text = Trim(text.substr(colon + 1));
+        colon = text.find(':');
+    }
+    if (text.empty()) {
+        return true;
+    }
+
+    auto space = text.find_first_of(" \t");
+    auto mnemonic = text.substr(0, space);
+    auto arguments = space == std::string::npos ? "" : Trim(text.substr(space));
+
+    Statement statement{};
+    statement.line = line;
+    statement.offset = m_offset;
+    if (mnemonic == ".origin") {
+        int64_t origin = 0;
+        if (!m_statements.empty() || !m_labels.empty()) {
+            return Fail(".origin must come before any words");
+        }
+        if (!ParseNumber(arguments, origin) || origin < 0) {
+            return Fail("invalid origin " + arguments);
+        }
+        image.load_address = origin;
+        return true;
+    } else if (mnemonic == ".entry") {
+        if (!IsIdentifier(arguments)) {
+            return Fail("invalid entry label " + arguments);
+        }
+        m_entry = arguments;
+        return true;
+    } else if (mnemonic == ".word") {
+        statement.is_data = true;
+        for (auto const& argument : Split(arguments, ',')) {
+            Value value{};
+            if (!ParseValue(argument, value)) {
+                return false;
+            }
+            statement.values.emplace_back(value);
+        }
+    } else if (mnemonic == ".space") {
+        int64_t num_words = 0;
+        if (!ParseNumber(arguments, num_words) || num_words <= 0) {
+            return Fail("invalid space " + arguments);
+        }
+        statement.is_data = true;
+        statement.values.resize(num_words);
+    } else if (!ParseInstruction(mnemonic, arguments, statement)) {
+        return false;
+    }
+
+    if (statement.is_data) {
+        m_offset += statement.values.size();
+    } else {
+        m_offset += FunctionalProcessorLibrary::EncodedSize(statement.instruction);
+        if (statement.instruction.result.type == Result::Type::MEMORY && IsWideResult(statement.result.label, statement.result.number)) {
+            m_offset += FunctionalProcessorLibrary::EXTEND_SIZE;
+        }
+    }
+    m_statements.emplace_back(std::move(statement));
+    return true;
+}
+
+bool Assembler::ParseInstruction(const std::string &mnemonic, const std::string &arguments, Statement &statement) {
+    auto name = mnemonic;
+    std::transform(name.begin(), name.end(), name.begin(), [](char c) { return std::toupper(c); });
+    auto opcode = Mnemonics().find(name);
+    if (opcode == Mnemonics().end()) {
+        return Fail("unknown mnemonic " + mnemonic);
+    }
+    auto& instruction = statement.instruction;
+    instruction.opcode = opcode->second;
+
+    auto arrow = arguments.find("->");
+    auto operands = Trim(arguments.substr(0, arrow));
+    if (!operands.empty()) {
+        for (auto const& text : Split(operands, ',')) {
+            instruction.operands.emplace_back();
+            statement.values.emplace_back();
+            if (!ParseOperand(text, instruction.operands.back(), statement.values.back())) {
+                return false;
+            }
+        }
+    }
+    auto num_operands = GetDetails(instruction.opcode).num_operands;
+    if (instruction.operands.size() != num_operands) {
+        return Fail(name + " takes " + std::to_string(num_operands) + " operands");
+    }
+
+    if (arrow != std::string::npos) {
+        auto result = Trim(arguments.substr(arrow + 2));
+        if (ParseRegister(result, instruction.result.location)) {
+            instruction.result.type = Result::Type::REGISTER;
+        } else if (ParseRegister(result, instruction.result.location, 'v')) {
+            instruction.result.type = Result::Type::VECTOR_REGISTER;
+        } else if (result.size() > 2 && result.front() == '[' && result.back() == ']') {
+            instruction.result.type = Result::Type::INDIRECT_MEMORY_REGISTER;
+            if (!ParseRegister(Trim(result.substr(1, result.size() - 2)), instruction.result.location)) {
+                return Fail("invalid indirect register " + result);
+            }
+        } else if (!result.empty() && result[0] == '@') {
+            instruction.result.type = Result::Type::MEMORY;
+            if (!ParseValue(result.substr(1), statement.result)) {
+                return false;
+            }
+        } else {
+            return Fail("invalid result " + result);
+        }
+    }
+    return true;
+}
+
+bool Assembler::ParseOperand(const std::string &text, Operand &operand, Value &value) {
+    if (text.size() > 2 && text.front() == '[' && text.back() == ']') {
+        operand.type = Operand::Type::INDIRECT_MEMORY_REGISTER;
+        if (!ParseRegister(Trim(text.substr(1, text.size() - 2)), operand.location)) {
+            return Fail("invalid indirect register " + text);
+        }
+        return true;
+    }
+    if (ParseRegister(text, operand.location)) {
+        operand.type = Operand::Type::REGISTER;
+        return true;
+    }
+    if (ParseRegister(text, operand.location, 'v')) {
+        operand.type = Operand::Type::VECTOR_REGISTER;
+        return true;
+    }
+    if (!text.empty() && text[0] == '#') {
+        operand.type = Operand::Type::CONSTANT;
+        return ParseValue(text.substr(1), value);
+    }
+    if (!ParseValue(text, value)) {
+        return false;
+    }
+    auto fits = value.label.empty() && value.number >= 0 && static_cast<uint64_t>(value.number) <= MAX_EMBEDDED;
+    if (fits) {
+        operand.type = Operand::Type::EMBEDDED;
+        operand.value = value.number;
+    } else {
+        operand.type = Operand::Type::CONSTANT;
+    }
+    return true;
+}
+
+bool Assembler::ParseValue(const std::string &text, Value &value) {
+    if (ParseNumber(text, value.number)) {
+        return true;
+    }
+    if (IsIdentifier(text)) {
+        value.label = text;
+        return true;
+    }
+    return Fail("invalid value " + text);
+}
+
+bool Assembler::Resolve(const Value &value, uint64_t &address) {
+    if (value.label.empty()) {
+        address = static_cast<uint64_t>(value.number);
+        return true;
+    }
+    auto label = m_labels.find(value.label);
+    if (label == m_labels.end()) {
+        return Fail("unknown label " + value.label);
+    }
+    address = label->second;
+    return true;
+}
+
+bool Assembler::Fail(const std::string &message) {
+    m_error = "line " + std::to_string(m_line) + ": " + message;
+    return false;
+}
+
+std::string Assembler::Disassemble(const std::vector<uint64_t> &words, uint64_t address) {
+    std::string text;
+    // EXTEND prefixes are folded into the instruction they widen, which is listed at the first prefix
+    std::array<uint64_t, FunctionalProcessorLibrary::EXTEND_RESULT + 1> extensions{};
+    uint8_t extended = 0;
+    uint64_t prefix_address = 0;
+    for (size_t i = 0; i < words.size(); i++) {
+        auto line_address = extended != 0 ? prefix_address : address + i;
+        auto opcode = static_cast<Opcode>(static_cast<uint16_t>(words[i]));
+        if (GetDetails().find(opcode) == GetDetails().end()) {
+            text += "    .word " + std::to_string(words[i]) + " ; " + std::to_string(address + i) + "\n";
+            extended = 0;
+            continue;
+        }
+        auto instruction = FunctionalProcessorLibrary::Decode(words[i]);
+        auto field = instruction.operands.empty() ? 0 : instruction.operands[0].value;
+        if (opcode == Opcode::EXTEND && i + 1 < words.size() && field >= 0 && field <= FunctionalProcessorLibrary::EXTEND_RESULT) {
+            prefix_address = line_address;
+            extensions[field] = words[++i];
+            extended |= static_cast<uint8_t>(1u << field);
+            continue;
+        }
+        for (size_t op = 0; op < instruction.operands.size(); op++) {
+            if ((extended >> op) & 1u) {
+                auto& operand = instruction.operands[op];
+                if (operand.type == Operand::Type::EMBEDDED) {
+                    operand.value = static_cast<int64_t>(extensions[op]);
+                } else {
+                    operand.location = extensions[op];
+                }
+            }
+        }
+        if ((extended >> FunctionalProcessorLibrary::EXTEND_RESULT) & 1u) {
+            instruction.result.location = extensions[FunctionalProcessorLibrary::EXTEND_RESULT];
+        }
+        extended = 0;
+        std::string line = "    " + to_string(instruction.opcode);
+        for (size_t op = 0; op < instruction.operands.size(); op++) {
+            auto const& operand = instruction.operands[op];
+            line += op == 0 ? " " : ", ";
+            switch (operand.type) {
+                case Operand::Type::REGISTER:
+                    line += "r" + std::to_string(operand.location);
+                    break;
+                case Operand::Type::CONSTANT:
+                    line += "#" + (i + 1 < words.size() ? std::to_string(static_cast<int64_t>(words[++i])) : "?");
+                    break;
+                case Operand::Type::INDIRECT_MEMORY_REGISTER:
+                    line += "[r" + std::to_string(operand.location) + "]";
+                    break;
+                case Operand::Type::EMBEDDED:
+                    line += std::to_string(operand.value);
+                    break;
+                case Operand::Type::VECTOR_REGISTER:
+                    line += "v" + std::to_string(operand.location);
+                    break;
+            }
+        }
+        switch (instruction.result.type) {
+            case Result::Type::NONE:
+                break;
+            case Result::Type::REGISTER:
+                line += " -> r" + std::to_string(instruction.result.location);
+                break;
+            case Result::Type::MEMORY:
+                line += " -> @" + std::to_string(instruction.result.location);
+                break;
+            case Result::Type::INDIRECT_MEMORY_REGISTER:
+                line += " -> [r" + std::to_string(instruction.result.location) + "]";
+                break;
+            case Result::Type::VECTOR_REGISTER:
+                line += " -> v" + std::to_string(instruction.result.location);
+                break;
+        }
+        text += line + " ; " + std::to_string(line_address) + "\n";
+    }
+    return text;
+}
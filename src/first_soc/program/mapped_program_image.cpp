@@ -0,0 +1,61 @@
+#include "program/mapped_program_image.h"
+
+#include <cstring>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+MappedProgramImage::MappedProgramImage(const std::string &file) {
+    auto fd = open(file.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return;
+    }
+    struct stat status{};
+    if (fstat(fd, &status) == 0 && status.st_size >= static_cast<off_t>(sizeof(m_header))) {
+        auto mapping = mmap(nullptr, status.st_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+        if (mapping != MAP_FAILED) {
+            m_data = static_cast<uint8_t*>(mapping);
+            m_size = status.st_size;
+            madvise(mapping, m_size, MADV_SEQUENTIAL);
+        }
+    }
+    close(fd);
+    if (m_data == nullptr) {
+        return;
+    }
+
+    std::memcpy(&m_header, m_data, sizeof(m_header));
+    // Bound the counts by the words actually in the file before adding them, a corrupt header could
+    // otherwise wrap the total around
+    auto available = (m_size - sizeof(m_header)) / sizeof(uint64_t);
+    if (std::memcmp(m_header.magic, ProgramImage::MAGIC, sizeof(ProgramImage::MAGIC)) != 0 ||
+        m_header.version != ProgramImage::VERSION ||
+        m_header.entry >= m_header.num_words ||
+        m_header.num_words > available ||
+        m_header.num_relocations > available - m_header.num_words) {
+        return;
+    }
+    m_words = reinterpret_cast<uint64_t*>(m_data + sizeof(m_header));
+    m_relocations = m_words + m_header.num_words;
+}
+
+MappedProgramImage::~MappedProgramImage() {
+    if (m_data != nullptr) {
+        munmap(m_data, m_size);
+    }
+}
+
+bool MappedProgramImage::Relocate(uint64_t address) {
+    auto delta = address - m_header.load_address;
+    for (uint64_t i = 0; i < m_header.num_relocations; i++) {
+        auto relocation = ProgramImage::Relocation::Unpack(m_relocations[i]);
+        if (relocation.offset >= m_header.num_words ||
+            !ProgramImage::Relocate(m_words[relocation.offset], relocation.field, delta)) {
+            return false;
+        }
+    }
+    m_header.load_address = address;
+    return true;
+}
@@ -0,0 +1,92 @@
+#include "program/program_image.h"
+
+#include <cstdio>
+#include <cstring>
+
+constexpr char ProgramImage::MAGIC[8];
+
+bool ProgramImage::Relocate(uint64_t address) {
+    auto delta = address - load_address;
+    for (auto const& relocation : relocations) {
+        if (relocation.offset >= words.size() || !Relocate(words[relocation.offset], relocation.field, delta)) {
+            return false;
+        }
+    }
+    load_address = address;
+    return true;
+}
+
+bool ProgramImage::Relocate(uint64_t &word, Relocation::Field field, uint64_t delta) {
+    switch (field) {
+        case Relocation::Field::WORD:
+            word += delta;
+            return true;
+    }
+    // Unknown field in a corrupt image
+    return false;
+}
+
+bool ProgramImage::Write(const std::string &file) const {
+    auto output = std::fopen(file.c_str(), "wb");
+    if (output == nullptr) {
+        return false;
+    }
+    ImageHeader header{};
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = VERSION;
+    header.load_address = load_address;
+    header.entry = entry;
+    header.num_words = words.size();
+    header.num_relocations = relocations.size();
+
+    std::vector<uint64_t> packed;
+    packed.reserve(relocations.size());
+    for (auto const& relocation : relocations) {
+        packed.emplace_back(relocation.Pack());
+    }
+
+    bool written = std::fwrite(&header, sizeof(header), 1, output) == 1 &&
+                   std::fwrite(words.data(), sizeof(uint64_t), words.size(), output) == words.size() &&
+                   std::fwrite(packed.data(), sizeof(uint64_t), packed.size(), output) == packed.size();
+    return std::fclose(output) == 0 && written;
+}
+
+bool ProgramImage::Read(const std::string &file) {
+    auto input = std::fopen(file.c_str(), "rb");
+    if (input == nullptr) {
+        return false;
+    }
+    ImageHeader header{};
+    if (std::fread(&header, sizeof(header), 1, input) != 1 ||
+        std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0 ||
+        header.version != VERSION ||
+        header.entry >= header.num_words) {
+        std::fclose(input);
+        return false;
+    }
+    // Size the buffers from the header only once it is known to fit in the file
+    long end = -1;
+    if (std::fseek(input, 0, SEEK_END) == 0) {
+        end = std::ftell(input);
+    }
+    auto available = end < static_cast<long>(sizeof(header)) ? 0 : (end - sizeof(header)) / sizeof(uint64_t);
+    if (header.num_words > available || header.num_relocations > available - header.num_words ||
+        std::fseek(input, sizeof(header), SEEK_SET) != 0) {
+        std::fclose(input);
+        return false;
+    }
+    load_address = header.load_address;
+    entry = header.entry;
+    words.resize(header.num_words);
+    std::vector<uint64_t> packed(header.num_relocations);
+    bool read = std::fread(words.data(), sizeof(uint64_t), words.size(), input) == words.size() &&
+                std::fread(packed.data(), sizeof(uint64_t), packed.size(), input) == packed.size();
+    std::fclose(input);
+
+    relocations.clear();
+    relocations.reserve(packed.size());
+    for (auto const& relocation : packed) {
+        relocations.emplace_back(Relocation::Unpack(relocation));
+    }
+    return read;
+}
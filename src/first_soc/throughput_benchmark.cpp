@@ -0,0 +1,252 @@
+#include "processor_test_bench.h"
+#include "timing/forked_run.h"
+
+#include <chrono>
+#include <cinttypes>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <string>
+#include <tuple>
+#include <vector>
+
+/**
+ * End to end simulator throughput across every processor model and loop driver mode at several
+ * sizes. The multithreaded processors also run one application per hardware thread context, the
+ * simulated instructions per cycle show how much latency the contexts hide. Every model also runs
+ * the benchmark kernel suite, reported with the kernel as the mode and its size as the ops. Every run
+ * happens in its own forked process so peak RSS is per run and no state leaks between runs.
+ *
+ * Usage: throughput_benchmark [-o output file] [-b baseline file] [-t regression threshold]
+ * With a baseline every run is compared against the matching baseline run and the exit code is 2 if
+ * any run got slower by more than the threshold (default 0.1, 10%). The exit code is 3 if any kernel
+ * produced the wrong result.
+ */
+
+struct Run {
+    std::string processor;
+    std::string mode;
+    uint64_t num_ops_per_iteration = 0;
+    uint64_t num_iterations = 0;
+    uint64_t num_contexts = 1;  /*!< Also the number of applications >*/
+    bool is_kernel = false;     /*!< Mode is a benchmark kernel and num_ops_per_iteration its size >*/
+};
+
+struct Measurement {
+    uint64_t cycles = 0;
+    uint64_t instructions = 0;
+    double wall_seconds = 0;
+    long peak_rss_kb = 0;
+    bool valid = false;
+    bool correct = true;        /*!< Kernel result matched its reference >*/
+};
+
+// One result per line, so results can be read back with the matching scanf format
+static constexpr char WRITE_FORMAT[] =
+        "    {\"processor\": \"%s\", \"mode\": \"%s\", \"ops_per_iteration\": %" PRIu64 ", \"iterations\": %" PRIu64 ", \"contexts\": %" PRIu64 ", "
+        "\"cycles\": %" PRIu64 ", \"instructions\": %" PRIu64 ", \"wall_seconds\": %.6f, \"peak_rss_kb\": %ld";
+static constexpr char READ_FORMAT[] =
+        " {\"processor\": \"%127[^\"]\", \"mode\": \"%127[^\"]\", \"ops_per_iteration\": %" SCNu64 ", \"iterations\": %" SCNu64 ", \"contexts\": %" SCNu64 ", "
+        "\"cycles\": %" SCNu64 ", \"instructions\": %" SCNu64 ", \"wall_seconds\": %lf, \"peak_rss_kb\": %ld";
+
+static std::vector<Run> Runs() {
+    const std::vector<std::string> processors = {
+            "functional_processor", "memory_bound_processor", "performant_processor", "pipelined_processor"};
+    const std::vector<std::string> modes = {"alu", "memory", "split", "random"};
+    const std::vector<std::pair<uint64_t, uint64_t>> sizes = {{64, 16}, {1024, 16}, {16384, 16}};
+    const std::vector<std::string> multithreaded = {"performant_processor", "pipelined_processor"};
+    const std::vector<uint64_t> contexts = {2, 4};
+    std::vector<Run> runs;
+    for (auto const& processor : processors) {
+        for (auto const& mode : modes) {
+            for (auto const& size : sizes) {
+                runs.push_back({processor, mode, size.first, size.second});
+            }
+        }
+    }
+    for (auto const& processor : multithreaded) {
+        for (auto const& mode : modes) {
+            for (auto num_contexts : contexts) {
+                runs.push_back({processor, mode, 1024, 16, num_contexts});
+            }
+        }
+    }
+    const std::vector<std::pair<std::string, uint64_t>> kernels = {
+            {"memcpy", 256}, {"dot", 256}, {"pointer_chase", 256}, {"histogram", 256}, {"matmul", 8}, {"reduction", 256}};
+    for (auto const& processor : processors) {
+        for (auto const& kernel : kernels) {
+            runs.push_back({processor, kernel.first, kernel.second, 1, 1, true});
+        }
+    }
+    return runs;
+}
+
+/**
+ * Build and clock one design to completion, only called in a forked child
+ */
+static Measurement Simulate(const Run& run) {
+    ProcessorTestBench test_bench{};
+    ProcessorTestBench::Config config{};
+    config.processor = run.processor;
+    config.mode = run.mode;
+    config.num_iterations = run.num_iterations;
+    config.num_ops_per_iteration = run.num_ops_per_iteration;
+    // Programs past the first few hundred words need EXTEND prefixes for their write back address
+    config.memory_size = run.num_contexts == 1 ? run.num_ops_per_iteration + 64 :
+                         (run.num_ops_per_iteration * 3 + 64) * run.num_contexts;
+    config.num_contexts = run.num_contexts;
+    config.num_applications = run.num_contexts;
+    if (run.is_kernel) {
+        config.application = "kernel_driver";
+        config.kernel = run.mode;
+        config.kernel_size = run.num_ops_per_iteration;
+        // Room for the kernel's data, matmul has three size x size matrices, plus its program
+        auto size = run.num_ops_per_iteration;
+        config.memory_size = (run.mode == "matmul" ? 3 * size * size : 4 * size) + 256;
+    }
+    test_bench.Build(config);
+
+    Measurement measurement{};
+    if (!test_bench.Validate()) {
+        return measurement;
+    }
+    test_bench.Setup();
+    auto start = std::chrono::steady_clock::now();
+    while (test_bench.Clock(1)) {
+        ++measurement.cycles;
+    }
+    auto end = std::chrono::steady_clock::now();
+    measurement.instructions = test_bench.GetCounterValue(test_bench.processor_name + ".functional.instructions.executed");
+    test_bench.TearDown();
+    if (run.is_kernel) {
+        // The kernel checks its result against the reference on tear down
+        measurement.correct = test_bench.GetCounterValue(test_bench.application_name + ".passed") == 1;
+    }
+
+    measurement.wall_seconds = std::chrono::duration<double>(end - start).count();
+    measurement.peak_rss_kb = PeakRssKb();
+    measurement.valid = true;
+    return measurement;
+}
+
+static Measurement Measure(const Run& run) {
+    Measurement measurement{};
+    if (!RunForked([&run]() { return Simulate(run); }, measurement)) {
+        measurement.valid = false;
+    }
+    return measurement;
+}
+
+using RunKey = std::tuple<std::string, std::string, uint64_t, uint64_t, uint64_t>;
+
+/**
+ * Read back a result file written by this tool
+ */
+static bool ReadResults(const std::string& file, std::map<RunKey, Measurement>& results) {
+    auto input = std::fopen(file.c_str(), "r");
+    if (input == nullptr) {
+        return false;
+    }
+    char line[1024];
+    while (std::fgets(line, sizeof(line), input) != nullptr) {
+        char processor[128];
+        char mode[128];
+        Run run{};
+        Measurement measurement{};
+        if (std::sscanf(line, READ_FORMAT, processor, mode, &run.num_ops_per_iteration, &run.num_iterations,
+                        &run.num_contexts, &measurement.cycles, &measurement.instructions, &measurement.wall_seconds,
+                        &measurement.peak_rss_kb) == 9) {
+            measurement.valid = true;
+            results[RunKey{processor, mode, run.num_ops_per_iteration, run.num_iterations, run.num_contexts}] = measurement;
+        }
+    }
+    std::fclose(input);
+    return true;
+}
+
+int main(int argc, char* argv[]) {
+    std::string output_file = "throughput_benchmark.json";
+    std::string baseline_file;
+    double threshold = 0.1;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        if (std::strcmp(argv[i], "-o") == 0) {
+            output_file = argv[i + 1];
+        } else if (std::strcmp(argv[i], "-b") == 0) {
+            baseline_file = argv[i + 1];
+        } else if (std::strcmp(argv[i], "-t") == 0) {
+            threshold = std::atof(argv[i + 1]);
+        } else {
+            printf("Usage: %s [-o output file] [-b baseline file] [-t regression threshold]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    std::map<RunKey, Measurement> baseline;
+    if (!baseline_file.empty() && !ReadResults(baseline_file, baseline)) {
+        printf("Failed to read baseline %s\n", baseline_file.c_str());
+        return 1;
+    }
+
+    auto output = std::fopen(output_file.c_str(), "w");
+    if (output == nullptr) {
+        printf("Failed to create %s\n", output_file.c_str());
+        return 1;
+    }
+    std::fprintf(output, "{\n  \"benchmark\": \"throughput\",\n  \"results\": [\n");
+
+    auto runs = Runs();
+    bool regressed = false;
+    bool wrong = false;
+    size_t written = 0;
+    printf("%-24s %-8s %8s %6s %4s %6s %14s %14s %10s %10s\n", "processor", "mode", "ops", "iters", "ctx",
+           "ipc", "cycles/s", "instrs/s", "rss kb", "vs base");
+    for (auto const& run : runs) {
+        auto measurement = Measure(run);
+        if (!measurement.valid) {
+            printf("%-24s %-8s %8" PRIu64 " %6" PRIu64 " %4" PRIu64 " failed\n", run.processor.c_str(), run.mode.c_str(),
+                   run.num_ops_per_iteration, run.num_iterations, run.num_contexts);
+            continue;
+        }
+        if (!measurement.correct) {
+            printf("%-24s %-8s %8" PRIu64 " %6" PRIu64 " %4" PRIu64 " wrong result\n", run.processor.c_str(), run.mode.c_str(),
+                   run.num_ops_per_iteration, run.num_iterations, run.num_contexts);
+            wrong = true;
+            continue;
+        }
+        auto cycles_per_second = measurement.cycles / measurement.wall_seconds;
+        auto instructions_per_second = measurement.instructions / measurement.wall_seconds;
+        std::fprintf(output, "%s", written == 0 ? "" : ",\n");
+        std::fprintf(output, WRITE_FORMAT, run.processor.c_str(), run.mode.c_str(), run.num_ops_per_iteration,
+                     run.num_iterations, run.num_contexts, measurement.cycles, measurement.instructions, measurement.wall_seconds,
+                     measurement.peak_rss_kb);
+        std::fprintf(output, ", \"cycles_per_second\": %.0f, \"instructions_per_second\": %.0f}",
+                     cycles_per_second, instructions_per_second);
+        ++written;
+
+        std::string comparison = "-";
+        auto base = baseline.find(RunKey{run.processor, run.mode, run.num_ops_per_iteration, run.num_iterations,
+                                         run.num_contexts});
+        if (base != baseline.end() && base->second.wall_seconds > 0) {
+            // Compare on instructions per second so runs stay comparable if the cycle count changes
+            auto base_rate = base->second.instructions / base->second.wall_seconds;
+            auto speedup = instructions_per_second / base_rate;
+            comparison = std::to_string(speedup).substr(0, 5) + "x";
+            if (speedup < 1.0 - threshold) {
+                comparison += " !";
+                regressed = true;
+            }
+        }
+        auto instructions_per_cycle = measurement.cycles == 0 ? 0.0 :
+                static_cast<double>(measurement.instructions) / measurement.cycles;
+        printf("%-24s %-8s %8" PRIu64 " %6" PRIu64 " %4" PRIu64 " %6.3f %14.0f %14.0f %10ld %10s\n", run.processor.c_str(), run.mode.c_str(),
+               run.num_ops_per_iteration, run.num_iterations, run.num_contexts, instructions_per_cycle,
+               cycles_per_second, instructions_per_second, measurement.peak_rss_kb, comparison.c_str());
+    }
+    std::fprintf(output, "\n  ]\n}\n");
+    std::fclose(output);
+    if (wrong) {
+        return 3;
+    }
+    return regressed ? 2 : 0;
+}
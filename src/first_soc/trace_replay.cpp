@@ -0,0 +1,66 @@
+#include "processor_test_bench.h"
+
+#include <cinttypes>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+/**
+ * Replays memory traces recorded with the memory_trace observer into the memory, without a processor.
+ * Usage: trace_replay [-m timed|back_pressure] [-n max outstanding reads] [-s memory size] <trace>...
+ */
+int main(int argc, char* argv[]) {
+    ProcessorTestBench::ReplayConfig config{};
+    for (int i = 1; i < argc; i++) {
+        bool has_value = i + 1 < argc;
+        if (has_value && std::strcmp(argv[i], "-m") == 0) {
+            config.mode = argv[++i];
+        } else if (has_value && std::strcmp(argv[i], "-n") == 0) {
+            config.max_outstanding = std::strtoull(argv[++i], nullptr, 10);
+        } else if (has_value && std::strcmp(argv[i], "-s") == 0) {
+            config.memory_size = std::strtoull(argv[++i], nullptr, 10);
+        } else {
+            config.trace_files.emplace_back(argv[i]);
+        }
+    }
+    if (config.trace_files.empty()) {
+        printf("Usage: %s [-m timed|back_pressure] [-n max outstanding reads] [-s memory size] <trace>...\n", argv[0]);
+        return 1;
+    }
+
+    // Instantiate our test bench
+    ProcessorTestBench test_bench{};
+    test_bench.BuildReplay(config);
+
+    // Validate the design
+    if (!test_bench.Validate()) {
+        printf("Model failed to validate, check the traces and the mode");
+        exit(1);
+    }
+
+    // Give everything a chance to setup
+    test_bench.Setup();
+
+    // Clock until no longer busy
+    uint64_t cycles = 0;
+    while (test_bench.Clock(1)) {
+        ++cycles;
+    }
+
+    printf("%" PRIu64 " cycles\n", cycles);
+    for (uint64_t i = 0; i < config.trace_files.size(); i++) {
+        auto name = ProcessorTestBench::ReplayDriverName(i) + ".";
+        auto reads = test_bench.GetCounterValue(name + "reads");
+        auto responses = test_bench.GetCounterValue(name + "responses");
+        auto latency = test_bench.GetCounterValue(name + "read_latency_cycles");
+        printf("%s: %" PRIu64 " reads, %" PRIu64 " writes, %.2f cycles average read latency, %" PRIu64 " late cycles\n",
+               config.trace_files[i].c_str(), reads, test_bench.GetCounterValue(name + "writes"),
+               responses == 0 ? 0.0 : static_cast<double>(latency) / responses,
+               test_bench.GetCounterValue(name + "late_cycles"));
+    }
+
+    // Tear down the design
+    test_bench.TearDown();
+
+    return 0;
+}
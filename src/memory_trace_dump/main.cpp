@@ -0,0 +1,32 @@
+#include "memory_trace/memory_trace_reader.h"
+
+#include <cinttypes>
+#include <cstdio>
+
+/**
+ * Prints a memory trace as text, one access per line.
+ * Usage: memory_trace_dump <memory trace>
+ */
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        printf("Usage: %s <memory trace>\n", argv[0]);
+        return 1;
+    }
+
+    memory_trace::MemoryTraceReader reader(argv[1]);
+    if (!reader.IsValid()) {
+        printf("Not a memory trace or unsupported compression: %s\n", argv[1]);
+        return 1;
+    }
+
+    memory_trace::Record record{};
+    while (reader.Next(record)) {
+        printf("%" PRIu64 " %s 0x%" PRIx64 " %" PRIu64 "\n", record.cycle, record.type == memory_trace::Type::WRITE ? "W" : "R",
+               record.address, record.size);
+    }
+    if (reader.IsCorrupted()) {
+        printf("Truncated memory trace: %s\n", argv[1]);
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,169 @@
+#include "counter_store/columnar_reader.h"
+
+#include "encoding/varint.h"
+
+#include <cstring>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace counter_store {
+
+ColumnarReader::ColumnarReader(const std::string &file) {
+    auto fd = open(file.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return;
+    }
+    struct stat status{};
+    if (fstat(fd, &status) == 0 && status.st_size >= static_cast<off_t>(sizeof(FileHeader))) {
+        auto mapping = mmap(nullptr, status.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (mapping != MAP_FAILED) {
+            m_data = static_cast<const uint8_t*>(mapping);
+            m_size = status.st_size;
+            madvise(mapping, m_size, MADV_SEQUENTIAL);
+        }
+    }
+    close(fd);
+    m_valid = m_data != nullptr && Parse();
+}
+
+ColumnarReader::~ColumnarReader() {
+    if (m_data != nullptr) {
+        munmap(const_cast<uint8_t*>(m_data), m_size);
+    }
+}
+
+bool ColumnarReader::Parse() {
+    std::memcpy(&m_header, m_data, sizeof(m_header));
+    if (std::memcmp(m_header.magic, MAGIC, sizeof(MAGIC)) != 0 || m_header.version != VERSION ||
+        m_header.num_columns == 0) {
+        return false;
+    }
+    // Schema
+    auto position = sizeof(FileHeader);
+    for (uint32_t column = 0; column < m_header.num_columns; column++) {
+        uint16_t length;
+        if (position + sizeof(length) > m_size) {
+            return false;
+        }
+        std::memcpy(&length, m_data + position, sizeof(length));
+        position += sizeof(length);
+        if (position + length > m_size) {
+            return false;
+        }
+        m_columns.emplace_back(reinterpret_cast<const char*>(m_data + position), length);
+        position += length;
+    }
+    // Block index, every offset and size in it is checked against the mapping before it is used
+    auto entry_size = sizeof(BlockEntry) + m_header.num_columns * sizeof(uint64_t);
+    if (m_header.index_offset % sizeof(uint64_t) != 0 || m_header.index_offset > m_size ||
+        m_header.num_blocks > (m_size - m_header.index_offset) / entry_size) {
+        return false;
+    }
+    auto index = m_data + m_header.index_offset;
+    uint64_t num_rows = 0;
+    for (uint64_t block = 0; block < m_header.num_blocks; block++) {
+        BlockEntry entry{};
+        std::memcpy(&entry, index, sizeof(entry));
+        if (entry.offset % sizeof(uint64_t) != 0 || entry.offset > m_header.index_offset ||
+            entry.size > m_header.index_offset - entry.offset || entry.num_rows > m_header.rows_per_block) {
+            return false;
+        }
+        auto column_offsets = reinterpret_cast<const uint64_t*>(index + sizeof(BlockEntry));
+        uint64_t previous = 0;
+        for (uint32_t column = 0; column < m_header.num_columns; column++) {
+            if (column_offsets[column] < previous || column_offsets[column] > entry.size ||
+                column_offsets[column] % sizeof(uint64_t) != 0) {
+                return false;
+            }
+            previous = column_offsets[column];
+        }
+        num_rows += entry.num_rows;
+        m_blocks.emplace_back(entry);
+        m_column_offsets.emplace_back(column_offsets);
+        index += entry_size;
+    }
+    return num_rows == m_header.num_rows;
+}
+
+size_t ColumnarReader::FindColumn(const std::string &name) const noexcept {
+    for (size_t column = 0; column < m_columns.size(); column++) {
+        if (m_columns[column] == name) {
+            return column;
+        }
+    }
+    return m_columns.size();
+}
+
+const uint8_t* ColumnarReader::ColumnStart(size_t block, size_t column) const noexcept {
+    return m_data + m_blocks[block].offset + m_column_offsets[block][column];
+}
+
+const uint8_t* ColumnarReader::ColumnEnd(size_t block, size_t column) const noexcept {
+    if (column + 1 < m_columns.size()) {
+        return ColumnStart(block, column + 1);
+    }
+    return m_data + m_blocks[block].offset + m_blocks[block].size;
+}
+
+const uint64_t* ColumnarReader::GetRawBlock(size_t block, size_t column) const noexcept {
+    if (m_header.encoding != Encoding::RAW) {
+        return nullptr;
+    }
+    return reinterpret_cast<const uint64_t*>(ColumnStart(block, column));
+}
+
+bool ColumnarReader::ReadBlock(size_t block, size_t column, std::vector<uint64_t> &values) const {
+    if (block >= m_blocks.size() || column >= m_columns.size()) {
+        return false;
+    }
+    auto num_rows = m_blocks[block].num_rows;
+    values.resize(num_rows);
+    auto in = ColumnStart(block, column);
+    auto end = ColumnEnd(block, column);
+    switch (m_header.encoding) {
+        case Encoding::RAW:
+            if (static_cast<size_t>(end - in) / sizeof(uint64_t) < num_rows) {
+                return false;
+            }
+            std::memcpy(values.data(), in, num_rows * sizeof(uint64_t));
+            return true;
+        case Encoding::VARINT:
+            for (uint32_t row = 0; row < num_rows; row++) {
+                if (!varint::Decode(in, end, values[row])) {
+                    return false;
+                }
+            }
+            return true;
+        case Encoding::DELTA_VARINT: {
+            uint64_t previous = 0;
+            for (uint32_t row = 0; row < num_rows; row++) {
+                uint64_t delta;
+                if (!varint::Decode(in, end, delta)) {
+                    return false;
+                }
+                previous += static_cast<uint64_t>(varint::ZigZagDecode(delta));
+                values[row] = previous;
+            }
+            return true;
+        }
+    }
+    return false;
+}
+
+bool ColumnarReader::ReadColumn(size_t column, std::vector<uint64_t> &values) const {
+    values.clear();
+    values.reserve(m_header.num_rows);
+    std::vector<uint64_t> block_values;
+    for (size_t block = 0; block < m_blocks.size(); block++) {
+        if (!ReadBlock(block, column, block_values)) {
+            return false;
+        }
+        values.insert(values.end(), block_values.begin(), block_values.end());
+    }
+    return true;
+}
+
+} // namespace counter_store
@@ -0,0 +1,152 @@
+#include "counter_store/columnar_writer.h"
+
+#include "encoding/varint.h"
+
+#include <cassert>
+#include <cstring>
+
+namespace counter_store {
+
+ColumnarWriter::ColumnarWriter(const std::string &file, std::vector<std::string> counters, Encoding encoding,
+                               uint32_t rows_per_block) :
+        m_num_columns(static_cast<uint32_t>(counters.size() + 1)),
+        m_rows_per_block(rows_per_block),
+        m_block(static_cast<size_t>(m_num_columns) * rows_per_block) {
+    assert(rows_per_block > 0);
+    std::memcpy(m_header.magic, MAGIC, sizeof(MAGIC));
+    m_header.version = VERSION;
+    m_header.encoding = encoding;
+    m_header.num_columns = m_num_columns;
+    m_header.rows_per_block = m_rows_per_block;
+
+    m_file = std::fopen(file.c_str(), "wb");
+    if (m_file == nullptr) {
+        m_failed = true;
+        return;
+    }
+    // Header is rewritten once we know how many rows and blocks we have
+    Write(&m_header, sizeof(m_header));
+    WriteSchema(counters);
+}
+
+ColumnarWriter::~ColumnarWriter() {
+    Close();
+}
+
+void ColumnarWriter::WriteSchema(const std::vector<std::string> &counters) {
+    std::vector<uint8_t> schema;
+    auto add_name = [&schema](const std::string& name) {
+        auto length = static_cast<uint16_t>(name.size());
+        auto bytes = reinterpret_cast<const uint8_t*>(&length);
+        schema.insert(schema.end(), bytes, bytes + sizeof(length));
+        schema.insert(schema.end(), name.begin(), name.begin() + length);
+    };
+    add_name("cycle");
+    for (auto const& counter : counters) {
+        add_name(counter);
+    }
+    schema.resize(AlignTo8(schema.size()), 0);
+    Write(schema.data(), schema.size());
+}
+
+void ColumnarWriter::Append(uint64_t cycle, const uint64_t *values) noexcept {
+    // Nothing would flush the block of a store that failed to open or was closed
+    if (m_file == nullptr) {
+        return;
+    }
+    auto row = m_block_rows;
+    m_block[row] = cycle;
+    for (uint32_t column = 1; column < m_num_columns; column++) {
+        m_block[static_cast<size_t>(column) * m_rows_per_block + row] = values[column - 1];
+    }
+    ++m_header.num_rows;
+    if (++m_block_rows == m_rows_per_block) {
+        FlushBlock();
+    }
+}
+
+void ColumnarWriter::FlushBlock() noexcept {
+    if (m_block_rows == 0 || m_file == nullptr) {
+        return;
+    }
+    m_encoded.clear();
+    m_column_offsets.clear();
+    for (uint32_t column = 0; column < m_num_columns; column++) {
+        m_column_offsets.emplace_back(m_encoded.size());
+        EncodeColumn(&m_block[static_cast<size_t>(column) * m_rows_per_block], m_block_rows);
+        m_encoded.resize(AlignTo8(m_encoded.size()), 0);
+    }
+
+    BlockEntry entry{};
+    entry.offset = m_offset;
+    entry.size = m_encoded.size();
+    entry.num_rows = m_block_rows;
+    m_blocks.emplace_back(entry);
+    m_block_column_offsets.insert(m_block_column_offsets.end(), m_column_offsets.begin(), m_column_offsets.end());
+
+    Write(m_encoded.data(), m_encoded.size());
+    m_block_rows = 0;
+}
+
+void ColumnarWriter::EncodeColumn(const uint64_t *column, uint32_t num_rows) {
+    switch (m_header.encoding) {
+        case Encoding::RAW: {
+            auto bytes = reinterpret_cast<const uint8_t*>(column);
+            m_encoded.insert(m_encoded.end(), bytes, bytes + num_rows * sizeof(uint64_t));
+            break;
+        }
+        case Encoding::VARINT: {
+            auto start = m_encoded.size();
+            m_encoded.resize(start + num_rows * varint::MAX_BYTES);
+            auto out = m_encoded.data() + start;
+            for (uint32_t row = 0; row < num_rows; row++) {
+                out += varint::Encode(column[row], out);
+            }
+            m_encoded.resize(out - m_encoded.data());
+            break;
+        }
+        case Encoding::DELTA_VARINT: {
+            auto start = m_encoded.size();
+            m_encoded.resize(start + num_rows * varint::MAX_BYTES);
+            auto out = m_encoded.data() + start;
+            uint64_t previous = 0;
+            for (uint32_t row = 0; row < num_rows; row++) {
+                out += varint::Encode(varint::ZigZagEncode(static_cast<int64_t>(column[row] - previous)), out);
+                previous = column[row];
+            }
+            m_encoded.resize(out - m_encoded.data());
+            break;
+        }
+    }
+}
+
+bool ColumnarWriter::Close() noexcept {
+    if (m_file == nullptr) {
+        return !m_failed;
+    }
+    FlushBlock();
+    m_header.num_blocks = m_blocks.size();
+    m_header.index_offset = m_offset;
+    for (size_t block = 0; block < m_blocks.size(); block++) {
+        Write(&m_blocks[block], sizeof(BlockEntry));
+        Write(&m_block_column_offsets[block * m_num_columns], m_num_columns * sizeof(uint64_t));
+    }
+    // A store whose header was not patched reads back as empty, so this has to succeed too
+    if (std::fseek(m_file, 0, SEEK_SET) != 0 || std::fwrite(&m_header, sizeof(m_header), 1, m_file) != 1) {
+        m_failed = true;
+    }
+    if (std::fclose(m_file) != 0) {
+        m_failed = true;
+    }
+    m_file = nullptr;
+    return !m_failed;
+}
+
+void ColumnarWriter::Write(const void *data, size_t size) noexcept {
+    if (size != 0 && std::fwrite(data, 1, size, m_file) != size) {
+        m_failed = true;
+    }
+    m_offset += size;
+}
+
+} // namespace counter_store
@@ -0,0 +1,102 @@
+#include "log/async_record_writer.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+
+AsyncRecordWriter::AsyncRecordWriter(const std::string &file, size_t record_size, size_t capacity, FullPolicy policy) :
+        m_record_size(record_size),
+        m_policy(policy) {
+    if (file.empty()) {
+        return;
+    }
+    m_file = std::fopen(file.c_str(), "wb");
+    if (m_file == nullptr) {
+        m_failed = true;
+        return;
+    }
+    while (m_capacity < capacity) {
+        m_capacity <<= 1u;
+    }
+    m_buffer.resize(m_capacity * m_record_size);
+
+    const char magic[8] = {'H', 'R', 'E', 'C', 'L', 'O', 'G', '\0'};
+    auto size = static_cast<uint32_t>(m_record_size);
+    if (std::fwrite(magic, sizeof(magic), 1, m_file) != 1 || std::fwrite(&VERSION, sizeof(VERSION), 1, m_file) != 1 ||
+        std::fwrite(&size, sizeof(size), 1, m_file) != 1) {
+        // Without a header the records cannot be read back, disable the writer
+        std::fclose(m_file);
+        m_file = nullptr;
+        m_failed = true;
+        return;
+    }
+
+    m_thread = std::thread(&AsyncRecordWriter::Drain, this);
+}
+
+AsyncRecordWriter::~AsyncRecordWriter() {
+    Close();
+}
+
+bool AsyncRecordWriter::Close() noexcept {
+    if (m_file == nullptr) {
+        return !HasFailed();
+    }
+    m_stop.store(true, std::memory_order_release);
+    m_wake.notify_one();
+    m_thread.join();
+    if (std::fclose(m_file) != 0) {
+        m_failed = true;
+    }
+    m_file = nullptr;
+    return !HasFailed();
+}
+
+bool AsyncRecordWriter::Write(const void *record) noexcept {
+    if (m_file == nullptr) {
+        return false;
+    }
+    auto head = m_head.load(std::memory_order_relaxed);
+    while (head - m_tail.load(std::memory_order_acquire) == m_capacity) {
+        if (m_policy == FullPolicy::DROP) {
+            ++m_num_dropped;
+            return false;
+        }
+        m_wake.notify_one();
+        std::this_thread::yield();
+    }
+    std::memcpy(&m_buffer[(head & (m_capacity - 1)) * m_record_size], record, m_record_size);
+    m_head.store(head + 1, std::memory_order_release);
+    // Only wake the background thread early when it is falling behind, otherwise it polls
+    if (head + 1 - m_tail.load(std::memory_order_relaxed) == m_capacity / 2) {
+        m_wake.notify_one();
+    }
+    return true;
+}
+
+void AsyncRecordWriter::Drain() {
+    while (true) {
+        auto tail = m_tail.load(std::memory_order_relaxed);
+        auto head = m_head.load(std::memory_order_acquire);
+        if (head == tail) {
+            // Write never runs concurrently with the destructor, so nothing arrives after stop
+            if (m_stop.load(std::memory_order_acquire) && m_head.load(std::memory_order_acquire) == tail) {
+                break;
+            }
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_wake.wait_for(lock, std::chrono::milliseconds(1));
+            continue;
+        }
+        // Write the contiguous part up to the end of the ring, the rest goes next time round
+        auto begin = tail & (m_capacity - 1);
+        auto count = std::min<uint64_t>(head - tail, m_capacity - begin);
+        // Records that could not be written are still consumed so Write never waits on a broken file
+        if (std::fwrite(&m_buffer[begin * m_record_size], m_record_size, count, m_file) != count) {
+            m_failed.store(true, std::memory_order_relaxed);
+        }
+        m_tail.store(tail + count, std::memory_order_release);
+    }
+    if (std::fflush(m_file) != 0) {
+        m_failed.store(true, std::memory_order_relaxed);
+    }
+}
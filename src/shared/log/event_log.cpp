@@ -0,0 +1,51 @@
+#include "log/event_log.h"
+
+EventLog::EventLog(const std::string &file, const std::vector<std::string> &names, size_t capacity) :
+        m_capacity(capacity) {
+    if (file.empty()) {
+        return;
+    }
+    m_file = std::fopen(file.c_str(), "wb");
+    if (m_file == nullptr) {
+        m_failed = true;
+        return;
+    }
+    m_records.reserve(m_capacity);
+
+    const char magic[8] = {'H', 'E', 'V', 'T', 'L', 'O', 'G', '\0'};
+    auto num_names = static_cast<uint32_t>(names.size());
+    bool written = std::fwrite(magic, sizeof(magic), 1, m_file) == 1 &&
+                   std::fwrite(&VERSION, sizeof(VERSION), 1, m_file) == 1 &&
+                   std::fwrite(&num_names, sizeof(num_names), 1, m_file) == 1;
+    for (auto const& name : names) {
+        auto length = static_cast<uint16_t>(name.size());
+        written = written && std::fwrite(&length, sizeof(length), 1, m_file) == 1 &&
+                  std::fwrite(name.data(), 1, length, m_file) == length;
+    }
+    // Without a complete header the records cannot be read back, so do not log at all
+    if (!written) {
+        Disable();
+    }
+}
+
+EventLog::~EventLog() {
+    if (m_file != nullptr) {
+        Flush();
+        std::fclose(m_file);
+    }
+}
+
+void EventLog::Flush() noexcept {
+    if (m_file != nullptr && !m_records.empty()) {
+        if (std::fwrite(m_records.data(), sizeof(Entry), m_records.size(), m_file) != m_records.size()) {
+            Disable();
+        }
+        m_records.clear();
+    }
+}
+
+void EventLog::Disable() noexcept {
+    std::fclose(m_file);
+    m_file = nullptr;
+    m_failed = true;
+}
@@ -0,0 +1,98 @@
+#include "memory_trace/memory_trace_reader.h"
+
+#include "encoding/varint.h"
+
+#include <cstring>
+
+#ifdef HAVE_ZLIB
+#include <zlib.h>
+#endif
+
+namespace memory_trace {
+
+MemoryTraceReader::MemoryTraceReader(const std::string &file) {
+    m_file = std::fopen(file.c_str(), "rb");
+    if (m_file == nullptr) {
+        return;
+    }
+    m_valid = std::fread(&m_header, sizeof(m_header), 1, m_file) == 1 &&
+              std::memcmp(m_header.magic, MAGIC, sizeof(MAGIC)) == 0 &&
+              m_header.version == VERSION &&
+              IsSupported(m_header.compression);
+}
+
+MemoryTraceReader::~MemoryTraceReader() {
+    if (m_file != nullptr) {
+        std::fclose(m_file);
+    }
+}
+
+bool MemoryTraceReader::Next(Record &record) noexcept {
+    if (m_block_records == 0 && !ReadBlock()) {
+        return false;
+    }
+    uint64_t cycle_delta = 0;
+    uint64_t size_and_type = 0;
+    uint64_t address_delta = 0;
+    if (!varint::Decode(m_position, m_end, cycle_delta) ||
+        !varint::Decode(m_position, m_end, size_and_type) ||
+        !varint::Decode(m_position, m_end, address_delta)) {
+        m_corrupted = true;
+        m_block_records = 0;
+        m_done = true;
+        return false;
+    }
+    m_previous_cycle += static_cast<uint64_t>(varint::ZigZagDecode(cycle_delta));
+    m_previous_address += static_cast<uint64_t>(varint::ZigZagDecode(address_delta));
+    record.cycle = m_previous_cycle;
+    record.address = m_previous_address;
+    record.size = size_and_type >> 1u;
+    record.type = static_cast<Type>(size_and_type & 1u);
+    --m_block_records;
+    return true;
+}
+
+bool MemoryTraceReader::ReadBlock() noexcept {
+    if (!m_valid || m_done) {
+        return false;
+    }
+    BlockHeader header{};
+    auto read = std::fread(&header, 1, sizeof(header), m_file);
+    if (read != sizeof(header)) {
+        // A partial header means the writer never finished the block
+        m_corrupted = read != 0;
+        m_done = true;
+        return false;
+    }
+    bool is_compressed = header.stored_size != header.raw_size;
+    m_block.resize(header.raw_size);
+    auto& stored = is_compressed ? m_stored : m_block;
+    stored.resize(header.stored_size);
+    if (header.num_records == 0 || (is_compressed && m_header.compression == Compression::NONE) ||
+        std::fread(stored.data(), 1, stored.size(), m_file) != stored.size()) {
+        m_corrupted = true;
+        m_done = true;
+        return false;
+    }
+
+#ifdef HAVE_ZLIB
+    if (is_compressed) {
+        auto size = static_cast<uLongf>(m_block.size());
+        if (uncompress(m_block.data(), &size, m_stored.data(), static_cast<uLong>(m_stored.size())) != Z_OK ||
+            size != m_block.size()) {
+            m_corrupted = true;
+            m_done = true;
+            return false;
+        }
+    }
+#endif
+
+    m_position = m_block.data();
+    m_end = m_block.data() + m_block.size();
+    m_block_records = header.num_records;
+    m_previous_cycle = 0;
+    m_previous_address = 0;
+    return true;
+}
+
+} // namespace memory_trace
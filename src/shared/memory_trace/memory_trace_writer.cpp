@@ -0,0 +1,90 @@
+#include "memory_trace/memory_trace_writer.h"
+
+#include <cassert>
+#include <cstring>
+
+#ifdef HAVE_ZLIB
+#include <zlib.h>
+#endif
+
+namespace memory_trace {
+
+static constexpr size_t MAX_RECORD_BYTES = 3 * varint::MAX_BYTES;
+
+MemoryTraceWriter::MemoryTraceWriter(const std::string &file, Compression compression, uint32_t records_per_block) :
+        m_block(records_per_block * MAX_RECORD_BYTES) {
+    // Block sizes have to fit the 32 bit fields of the block header
+    assert(records_per_block > 0 && records_per_block <= (1u << 24u));
+    std::memcpy(m_header.magic, MAGIC, sizeof(MAGIC));
+    m_header.version = VERSION;
+    m_header.compression = IsSupported(compression) ? compression : Compression::NONE;
+    m_header.records_per_block = records_per_block;
+
+    m_file = std::fopen(file.c_str(), "wb");
+    if (m_file == nullptr) {
+        m_failed = true;
+        return;
+    }
+    // Header is rewritten once we know how many records we have
+    Write(&m_header, sizeof(m_header));
+}
+
+MemoryTraceWriter::~MemoryTraceWriter() {
+    Close();
+}
+
+void MemoryTraceWriter::FlushBlock() noexcept {
+    if (m_block_records == 0 || m_file == nullptr) {
+        return;
+    }
+    BlockHeader header{};
+    header.num_records = m_block_records;
+    header.raw_size = static_cast<uint32_t>(m_block_size);
+    header.stored_size = header.raw_size;
+    const uint8_t* stored = m_block.data();
+
+#ifdef HAVE_ZLIB
+    if (m_header.compression == Compression::ZLIB) {
+        // Fastest level, the varints already took out most of the redundancy
+        auto size = compressBound(static_cast<uLong>(m_block_size));
+        m_compressed.resize(size);
+        if (compress2(m_compressed.data(), &size, m_block.data(), static_cast<uLong>(m_block_size), 1) == Z_OK &&
+            size < m_block_size) {
+            header.stored_size = static_cast<uint32_t>(size);
+            stored = m_compressed.data();
+        }
+    }
+#endif
+
+    Write(&header, sizeof(header));
+    Write(stored, header.stored_size);
+    m_block_size = 0;
+    m_block_records = 0;
+    m_previous_cycle = 0;
+    m_previous_address = 0;
+}
+
+bool MemoryTraceWriter::Close() noexcept {
+    if (m_file == nullptr) {
+        return !m_failed;
+    }
+    FlushBlock();
+    if (std::fseek(m_file, 0, SEEK_SET) != 0) {
+        m_failed = true;
+    } else {
+        Write(&m_header, sizeof(m_header));
+    }
+    if (std::fclose(m_file) != 0) {
+        m_failed = true;
+    }
+    m_file = nullptr;
+    return !m_failed;
+}
+
+void MemoryTraceWriter::Write(const void *data, size_t size) noexcept {
+    if (size != 0 && std::fwrite(data, 1, size, m_file) != size) {
+        m_failed = true;
+    }
+}
+
+} // namespace memory_trace
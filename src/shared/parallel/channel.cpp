@@ -0,0 +1,34 @@
+
+#include "parallel/channel.h"
+
+#include <algorithm>
+#include <limits>
+
+ChannelRegistry& ChannelRegistry::Instance() {
+    static ChannelRegistry registry;
+    return registry;
+}
+
+bool ChannelRegistry::Empty() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (auto const& channel : m_channels) {
+        if (!channel.second->Empty()) {
+            return false;
+        }
+    }
+    return true;
+}
+
+uint64_t ChannelRegistry::Lookahead() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    uint64_t lookahead = std::numeric_limits<uint64_t>::max();
+    for (auto const& channel : m_channels) {
+        lookahead = std::min(lookahead, channel.second->latency);
+    }
+    return m_channels.empty() ? 1 : lookahead;
+}
+
+void ChannelRegistry::Clear() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_channels.clear();
+}
@@ -0,0 +1,75 @@
+
+#include "parallel/parallel_simulation.h"
+#include "parallel/channel.h"
+
+#include <algorithm>
+#include <thread>
+
+void ParallelSimulation::Barrier::Wait() {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    auto generation = m_generation;
+    if (++m_arrived == m_num_threads) {
+        m_arrived = 0;
+        m_completion();
+        ++m_generation;
+        m_condition.notify_all();
+        return;
+    }
+    m_condition.wait(lock, [&] { return generation != m_generation; });
+}
+
+ParallelSimulation::ParallelSimulation(size_t num_threads) :
+        m_num_threads(num_threads != 0 ? num_threads : std::max(1u, std::thread::hardware_concurrency())) {}
+
+void ParallelSimulation::AddPartition(hestia::CppTestBench& test_bench) {
+    m_partitions.push_back(&test_bench);
+}
+
+uint64_t ParallelSimulation::Run() {
+    // Never more threads than partitions, a thread with nothing to clock only adds barrier traffic
+    m_num_threads = std::max<size_t>(1, std::min(m_num_threads, m_partitions.size()));
+    m_epoch_cycles = std::max<uint64_t>(1, ChannelRegistry::Instance().Lookahead());
+    m_last_busy_cycle.assign(m_partitions.size(), 0);
+    m_busy.assign(m_num_threads, 0);
+    m_cycle = 0;
+    m_num_epochs = 0;
+    m_done = false;
+    if (m_partitions.empty()) {
+        return 0;
+    }
+
+    Barrier barrier(m_num_threads, [this] { EndEpoch(); });
+    std::vector<std::thread> workers;
+    for (size_t thread = 1; thread < m_num_threads; thread++) {
+        workers.emplace_back(&ParallelSimulation::Worker, this, thread, std::ref(barrier));
+    }
+    Worker(0, barrier);
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    return *std::max_element(m_last_busy_cycle.begin(), m_last_busy_cycle.end());
+}
+
+void ParallelSimulation::Worker(size_t thread, Barrier& barrier) {
+    while (!m_done) {
+        bool busy = false;
+        // Partitions are dealt out round robin, the same partition always lands on the same thread
+        for (size_t partition = thread; partition < m_partitions.size(); partition += m_num_threads) {
+            for (uint64_t cycle = 0; cycle < m_epoch_cycles; cycle++) {
+                if (m_partitions[partition]->Clock(1)) {
+                    busy = true;
+                    m_last_busy_cycle[partition] = m_cycle + cycle + 1;
+                }
+            }
+        }
+        m_busy[thread] = busy;
+        barrier.Wait();
+    }
+}
+
+void ParallelSimulation::EndEpoch() {
+    ++m_num_epochs;
+    m_cycle += m_epoch_cycles;
+    bool busy = std::any_of(m_busy.begin(), m_busy.end(), [](char thread_busy) { return thread_busy != 0; });
+    m_done = !busy && ChannelRegistry::Instance().Empty();
+}
@@ -0,0 +1,111 @@
+
+#include "python/test_bench_views.h"
+#include "reset/reset_handler.h"
+
+#include <map>
+#include <set>
+#include <vector>
+
+struct CounterArray {
+    std::vector<std::string> names;
+    std::vector<uint64_t> values;
+    std::vector<uint64_t> baselines;  /*!< Raw values at the last reset >*/
+    std::vector<uint64_t> history;  /*!< Row major, cycle then values >*/
+};
+
+namespace {
+
+struct ViewMemory {
+    hestia::IMemory* memory = nullptr;
+    std::vector<hestia::IMemory::Data> buffer;
+};
+
+hestia::CppTestBench* view_test_bench = nullptr;
+std::map<std::string, ViewMemory> view_memories;
+std::set<CounterArray*> view_counter_arrays;
+
+}
+
+void SetViewTestBench(hestia::CppTestBench* test_bench) noexcept {
+    view_test_bench = test_bench;
+    view_memories.clear();
+}
+
+void RegisterViewMemory(const std::string& name, hestia::IMemory* memory) {
+    view_memories[name].memory = memory;
+}
+
+CounterArray* CreateCounterArray(const char* const* names, size_t num_names) {
+    auto array = new CounterArray();
+    array->names.assign(names, names + num_names);
+    array->values.resize(num_names);
+    array->baselines.resize(num_names);
+    view_counter_arrays.insert(array);
+    return array;
+}
+
+void DestroyCounterArray(CounterArray* array) {
+    view_counter_arrays.erase(array);
+    delete array;
+}
+
+const uint64_t* ReadCounterArray(CounterArray* array) {
+    for (size_t i = 0; i < array->names.size(); i++) {
+        array->values[i] = view_test_bench->GetCounterValue(array->names[i]) - array->baselines[i];
+    }
+    return array->values.data();
+}
+
+void SampleCounterArray(CounterArray* array, uint64_t cycle) {
+    ReadCounterArray(array);
+    array->history.push_back(cycle);
+    array->history.insert(array->history.end(), array->values.begin(), array->values.end());
+}
+
+const uint64_t* GetCounterHistory(CounterArray* array, size_t* num_rows) {
+    *num_rows = array->history.size() / (array->names.size() + 1);
+    return array->history.data();
+}
+
+void ReserveCounterHistory(CounterArray* array, size_t num_rows) {
+    array->history.reserve(num_rows * (array->names.size() + 1));
+}
+
+void ClearCounterHistory(CounterArray* array) {
+    array->history.clear();
+}
+
+const uint64_t* ReadMemory(const char* memory_name, uint64_t address, uint64_t size) {
+    auto found = view_memories.find(memory_name);
+    if (found == view_memories.end()) {
+        return nullptr;
+    }
+    found->second.buffer = found->second.memory->Get(address, size);
+    return found->second.buffer.data();
+}
+
+bool WriteMemory(const char* memory_name, uint64_t address, const uint64_t* data, uint64_t size) {
+    auto found = view_memories.find(memory_name);
+    if (found == view_memories.end()) {
+        return false;
+    }
+    found->second.memory->Set(address, data, size);
+    return true;
+}
+
+size_t ResetDesign(const char* reset_group) {
+    for (auto array : view_counter_arrays) {
+        for (size_t i = 0; i < array->names.size(); i++) {
+            array->baselines[i] = view_test_bench->GetCounterValue(array->names[i]);
+        }
+    }
+    return ResetRegistry::Instance().Reset(reset_group);
+}
+
+size_t SetParameters(const char* const* components, const char* const* names, const char* const* values,
+                     size_t num_parameters) {
+    for (size_t i = 0; i < num_parameters; i++) {
+        view_test_bench->SetParameter(hestia::FrameworkType::COMPONENT, components[i], names[i], values[i]);
+    }
+    return num_parameters;
+}
@@ -0,0 +1,52 @@
+
+#include "reset/reset_handler.h"
+
+#include <algorithm>
+
+ResetHandler::ResetHandler(std::string group, std::function<void()> handler) :
+        m_group(std::move(group)),
+        m_handler(std::move(handler)) {
+    if (!m_group.empty()) {
+        ResetRegistry::Instance().Add(m_group, this);
+    }
+}
+
+ResetHandler::~ResetHandler() {
+    if (!m_group.empty()) {
+        ResetRegistry::Instance().Remove(m_group, this);
+    }
+}
+
+ResetRegistry& ResetRegistry::Instance() {
+    static ResetRegistry registry;
+    return registry;
+}
+
+size_t ResetRegistry::Reset(const std::string& group) {
+    std::vector<ResetHandler*> handlers;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto found = m_groups.find(group);
+        if (found != m_groups.end()) {
+            handlers = found->second;
+        }
+    }
+    for (auto handler : handlers) {
+        (*handler)();
+    }
+    return handlers.size();
+}
+
+void ResetRegistry::Add(const std::string& group, ResetHandler* handler) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_groups[group].push_back(handler);
+}
+
+void ResetRegistry::Remove(const std::string& group, ResetHandler* handler) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto& handlers = m_groups[group];
+    handlers.erase(std::remove(handlers.begin(), handlers.end(), handler), handlers.end());
+    if (handlers.empty()) {
+        m_groups.erase(group);
+    }
+}
@@ -0,0 +1,88 @@
+#include "trace/chrome_trace.h"
+
+#include <cinttypes>
+#include <cstdio>
+
+/**
+ * Escape a name for use inside a JSON string
+ */
+static std::string Escape(const std::string& name) {
+    std::string escaped;
+    escaped.reserve(name.size());
+    for (char c : name) {
+        if (c == '"' || c == '\\') {
+            escaped += '\\';
+            escaped += c;
+        } else if (static_cast<unsigned char>(c) < 0x20u) {
+            char code[7];
+            std::snprintf(code, sizeof(code), "\\u%04x", static_cast<unsigned>(c));
+            escaped += code;
+        } else {
+            escaped += c;
+        }
+    }
+    return escaped;
+}
+
+auto ChromeTrace::AddTrack(const std::string &name) -> Track {
+    m_tracks.emplace_back(name);
+    m_open.emplace_back(NOT_OPEN);
+    return static_cast<Track>(m_tracks.size() - 1);
+}
+
+auto ChromeTrace::AddName(const std::string &name) -> Name {
+    auto found = m_name_lookup.find(name);
+    if (found != m_name_lookup.end()) {
+        return found->second;
+    }
+    auto index = static_cast<Name>(m_names.size());
+    m_names.emplace_back(name);
+    m_name_lookup.emplace(name, index);
+    return index;
+}
+
+void ChromeTrace::Begin(Track track, uint64_t cycle) {
+    if (m_open[track] == NOT_OPEN) {
+        m_open[track] = cycle;
+    }
+}
+
+void ChromeTrace::End(Track track, Name name, uint64_t cycle) {
+    if (m_open[track] != NOT_OPEN) {
+        Complete(track, name, m_open[track], cycle, m_events.size());
+        m_open[track] = NOT_OPEN;
+    }
+}
+
+bool ChromeTrace::Write(const std::string &file) const {
+    auto output = std::fopen(file.c_str(), "w");
+    if (output == nullptr) {
+        return false;
+    }
+    std::vector<char> buffer(1u << 20u);
+    std::setvbuf(output, buffer.data(), _IOFBF, buffer.size());
+
+    std::fprintf(output, "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n");
+    std::fprintf(output, "{\"ph\":\"M\",\"pid\":0,\"name\":\"process_name\",\"args\":{\"name\":\"%s\"}}",
+                 Escape(m_process_name).c_str());
+    for (size_t track = 0; track < m_tracks.size(); track++) {
+        std::fprintf(output, ",\n{\"ph\":\"M\",\"pid\":0,\"tid\":%zu,\"name\":\"thread_name\",\"args\":{\"name\":\"%s\"}}",
+                     track, Escape(m_tracks[track]).c_str());
+        std::fprintf(output, ",\n{\"ph\":\"M\",\"pid\":0,\"tid\":%zu,\"name\":\"thread_sort_index\",\"args\":{\"sort_index\":%zu}}",
+                     track, track);
+    }
+    // Names are interned, so escape each once rather than once per event
+    std::vector<std::string> names;
+    names.reserve(m_names.size());
+    for (auto const& name : m_names) {
+        names.emplace_back(Escape(name));
+    }
+    for (auto const& event : m_events) {
+        std::fprintf(output, ",\n{\"ph\":\"X\",\"pid\":0,\"tid\":%u,\"name\":\"%s\",\"ts\":%" PRIu64 ",\"dur\":%" PRIu64 ",\"args\":{\"id\":%" PRIu64 "}}",
+                     event.track, names[event.name].c_str(), event.start, event.duration, event.id);
+    }
+    std::fprintf(output, "\n]}\n");
+    auto failed = std::ferror(output) != 0;
+    std::fclose(output);
+    return !failed;
+}